@@ -0,0 +1,145 @@
+#include "shared/solver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <map>
+#include <print>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::duration<double>;
+
+struct Stats {
+    Duration min;
+    Duration median;
+    Duration p99;
+    std::size_t runs{0};
+};
+
+// Extra arguments a solver needs next to its input; day8 part1 is scored after 1000 connections.
+const auto extraArgs = std::map<std::pair<int, int>, std::vector<const char*>>{{{8, 1}, {"1000"}}};
+
+std::vector<std::filesystem::path> inputs(int day) {
+    auto result = std::vector<std::filesystem::path>{};
+
+    const auto input = std::filesystem::path{std::format("day{}/input.txt", day)};
+    if (std::filesystem::exists(input)) {
+        result.push_back(input);
+    }
+
+    const auto synthetic = std::filesystem::path{std::format("build/inputs/day{}", day)};
+    if (std::filesystem::is_directory(synthetic)) {
+        auto generated = std::filesystem::directory_iterator{synthetic} |
+                         std::views::transform([](const auto& entry) { return entry.path(); }) |
+                         std::ranges::to<std::vector>();
+        std::ranges::sort(generated);
+        std::ranges::copy(generated, std::back_inserter(result));
+    }
+
+    return result;
+}
+
+Duration percentile(const std::vector<Duration>& sorted, double p) {
+    assert(!sorted.empty());
+    const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+// Repeats until the median moves less than 1% between checkpoints of minRuns samples, or a budget runs out.
+Stats measure(Solver solver, Args args, std::string& answer) {
+    static constexpr auto minRuns = std::size_t{10};
+    static constexpr auto maxRuns = std::size_t{1000};
+    static constexpr auto maxTime = Duration{10.0};
+    static constexpr auto tolerance = 0.01;
+
+    answer = solver(args);
+
+    auto samples = std::vector<Duration>{};
+    auto total = Duration{0};
+    auto prevMedian = Duration{0};
+
+    while ((samples.size() < maxRuns) && (total < maxTime)) {
+        const auto start = Clock::now();
+        [[maybe_unused]] const auto result = solver(args);
+        const auto elapsed = Duration{Clock::now() - start};
+        assert(result == answer);
+
+        samples.push_back(elapsed);
+        total += elapsed;
+
+        if ((samples.size() % minRuns) == 0) {
+            auto sorted = samples;
+            std::ranges::sort(sorted);
+            const auto median = percentile(sorted, 0.5);
+            if (std::chrono::abs(median - prevMedian) <= (median * tolerance)) {
+                break;
+            }
+            prevMedian = median;
+        }
+    }
+
+    std::ranges::sort(samples);
+    return Stats{.min = samples.front(),
+                 .median = percentile(samples, 0.5),
+                 .p99 = percentile(samples, 0.99),
+                 .runs = samples.size()};
+}
+
+std::string formatRate(double bytesPerSecond) {
+    static constexpr auto units = std::array{"B/s", "KB/s", "MB/s", "GB/s"};
+
+    auto unit = 0uz;
+    while ((bytesPerSecond >= 1000.0) && ((unit + 1) < units.size())) {
+        bytesPerSecond /= 1000.0;
+        ++unit;
+    }
+    return std::format("{:.1f} {}", bytesPerSecond, units[unit]);
+}
+
+bool isSelected(const SolverInfo& info, std::span<const char* const> filters) {
+    return filters.empty() || std::ranges::any_of(filters, [&info](std::string_view filter) {
+               return (filter == std::format("{}", info.day)) || (filter == std::format("{}.{}", info.day, info.part));
+           });
+}
+
+int main(int argc, const char** argv) {
+    const auto filters = std::span<const char* const>{argv + 1, argv + argc};
+
+    auto all = solvers();
+    std::ranges::sort(all, {}, [](const auto& info) { return std::pair{info.day, info.part}; });
+
+    std::println("{:<8} {:<32} {:>6} {:>12} {:>12} {:>12} {:>14}  {}", "solver", "input", "runs", "min [ms]",
+                 "median [ms]", "p99 [ms]", "throughput", "answer");
+
+    for (const auto& info : all | std::views::filter([&](const auto& i) { return isSelected(i, filters); })) {
+        for (const auto& input : inputs(info.day)) {
+            auto args = std::vector<const char*>{input.c_str()};
+            if (const auto it = extraArgs.find({info.day, info.part}); it != extraArgs.end()) {
+                std::ranges::copy(it->second, std::back_inserter(args));
+            }
+
+            auto answer = std::string{};
+            const auto stats = measure(info.solver, args, answer);
+            const auto bytes = static_cast<double>(std::filesystem::file_size(input));
+            const auto ms = [](Duration d) { return d.count() * 1000.0; };
+
+            std::println("{:<8} {:<32} {:>6} {:>12.3f} {:>12.3f} {:>12.3f} {:>14}  {}",
+                         std::format("{}.{}", info.day, info.part), input.string(), stats.runs, ms(stats.min),
+                         ms(stats.median), ms(stats.p99), formatRate(bytes / stats.median.count()), answer);
+        }
+    }
+
+    instrument::report();
+}
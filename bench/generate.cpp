@@ -0,0 +1,260 @@
+#include "shared/shared.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <format>
+#include <print>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using Rng = std::mt19937_64;
+
+struct Options {
+    std::size_t size{0};
+    std::size_t width{0};
+};
+
+std::uint64_t uniform(Rng& rng, std::uint64_t min, std::uint64_t max) {
+    return std::uniform_int_distribution<std::uint64_t>{min, max}(rng);
+}
+
+bool chance(Rng& rng, double p) { return std::bernoulli_distribution{p}(rng); }
+
+std::string digits(Rng& rng, std::size_t count, char min) {
+    auto result = std::string(count, '0');
+    std::ranges::generate(result, [&] { return static_cast<char>(uniform(rng, min, '9')); });
+    return result;
+}
+
+template <typename R>
+std::string join(const R& range) {
+    return range | std::views::transform([](auto i) { return std::to_string(i); }) | std::views::join_with(',') |
+           std::ranges::to<std::string>();
+}
+
+// size: rotations
+void generateDay1(Rng& rng, Options options) {
+    for (auto i = 0uz; i < options.size; ++i) {
+        std::println("{}{}", chance(rng, 0.5) ? 'L' : 'R', uniform(rng, 1, 999));
+    }
+}
+
+// size: ranges, width: maximum range width
+void generateDay2(Rng& rng, Options options) {
+    const auto width = (options.width == 0) ? 100000 : options.width;
+
+    auto line = std::string{};
+    for (auto i = 0uz; i < options.size; ++i) {
+        const auto from = uniform(rng, 1, 10000000000);
+        line += std::format("{}{}-{}", (i == 0) ? "" : ",", from, from + uniform(rng, 0, width));
+    }
+    std::println("{}", line);
+}
+
+// size: banks, width: digits per bank
+void generateDay3(Rng& rng, Options options) {
+    const auto width = std::max(12uz, (options.width == 0) ? 100 : options.width);
+
+    for (auto i = 0uz; i < options.size; ++i) {
+        std::println("{}", digits(rng, width, '1'));
+    }
+}
+
+// size: rows, width: columns
+void generateDay4(Rng& rng, Options options) {
+    const auto width = (options.width == 0) ? options.size : options.width;
+
+    auto line = std::string(width, '.');
+    for (auto i = 0uz; i < options.size; ++i) {
+        std::ranges::generate(line, [&] { return chance(rng, 0.6) ? '@' : '.'; });
+        std::println("{}", line);
+    }
+}
+
+// size: ranges, width: available ids
+void generateDay5(Rng& rng, Options options) {
+    static constexpr auto maxId = std::uint64_t{100000000000000};
+
+    const auto width = (options.width == 0) ? options.size : options.width;
+
+    for (auto i = 0uz; i < options.size; ++i) {
+        const auto start = uniform(rng, 1, maxId);
+        std::println("{}-{}", start, start + uniform(rng, 0, 10000000000));
+    }
+    std::println();
+    for (auto i = 0uz; i < width; ++i) {
+        std::println("{}", uniform(rng, 1, maxId));
+    }
+}
+
+// size: problems, width: operand rows
+void generateDay6(Rng& rng, Options options) {
+    const auto rows = (options.width == 0) ? 4 : options.width;
+
+    auto lines = std::vector<std::string>(rows + 1);
+    for (auto i = 0uz; i < options.size; ++i) {
+        const auto width = uniform(rng, 1, 4);
+        const auto full = uniform(rng, 0, rows - 1);
+        const auto leftAligned = chance(rng, 0.5);
+
+        for (auto row = 0uz; row < rows; ++row) {
+            const auto nr = digits(rng, (row == full) ? width : uniform(rng, 1, width), '1');
+            const auto padding = std::string(width - nr.size(), ' ');
+            lines[row] += (i == 0) ? "" : " ";
+            lines[row] += leftAligned ? (nr + padding) : (padding + nr);
+        }
+
+        lines.back() += (i == 0) ? "" : " ";
+        lines.back() += (chance(rng, 0.5) ? '+' : '*') + std::string(width - 1, ' ');
+    }
+
+    std::ranges::for_each(lines, [](const auto& line) { std::println("{}", line); });
+}
+
+// size: columns, width: rows
+void generateDay7(Rng& rng, Options options) {
+    const auto rows = (options.width == 0) ? options.size : options.width;
+
+    auto line = std::string(options.size, '.');
+    line[options.size / 2] = 'S';
+    std::println("{}", line);
+
+    for (auto row = 1uz; row < rows; ++row) {
+        std::ranges::generate(line, [&] { return (((row % 2) == 0) && chance(rng, 0.3)) ? '^' : '.'; });
+        std::println("{}", line);
+    }
+}
+
+// size: boxes
+void generateDay8(Rng& rng, Options options) {
+    for (auto i = 0uz; i < options.size; ++i) {
+        std::println("{},{},{}", uniform(rng, 0, 99999), uniform(rng, 0, 99999), uniform(rng, 0, 99999));
+    }
+}
+
+// size: vertices of a histogram-shaped rectilinear polygon, width: maximum height
+void generateDay9(Rng& rng, Options options) {
+    const auto maxHeight = (options.width == 0) ? 100000 : options.width;
+    const auto nrColumns = std::max(1uz, (options.size / 2) - 1);
+
+    auto x = uniform(rng, 0, 100);
+    auto height = std::uint64_t{0};
+
+    std::println("{},{}", x, 0);
+    for (auto i = 0uz; i < nrColumns; ++i) {
+        auto next = height;
+        while (next == height) {
+            next = uniform(rng, 1, maxHeight);
+        }
+        height = next;
+
+        std::println("{},{}", x, height);
+        x += uniform(rng, 2, 100);
+        std::println("{},{}", x, height);
+    }
+    std::println("{},{}", x, 0);
+}
+
+// size: machines, width: buttons per machine
+void generateDay10(Rng& rng, Options options) {
+    const auto nrButtons = (options.width == 0) ? 10 : options.width;
+
+    for (auto i = 0uz; i < options.size; ++i) {
+        const auto nrLights = uniform(rng, 4, 10);
+
+        auto buttons = std::vector<std::vector<std::size_t>>{};
+        auto lights = std::string(nrLights, '.');
+        for (auto b = 0uz; b < nrButtons; ++b) {
+            auto button = std::views::iota(0uz, nrLights) | std::ranges::to<std::vector>();
+            std::ranges::shuffle(button, rng);
+            button.resize(uniform(rng, 1, nrLights));
+            std::ranges::sort(button);
+
+            // The target is reachable by construction: it is the result of pressing some buttons.
+            if ((b + 1 < nrButtons) && chance(rng, 0.5)) {
+                std::ranges::for_each(button, [&lights](auto l) { lights[l] = (lights[l] == '.') ? '#' : '.'; });
+            }
+
+            buttons.push_back(std::move(button));
+        }
+
+        auto line = std::format("[{}]", lights);
+        for (const auto& button : buttons) {
+            line += std::format(" ({})", join(button));
+        }
+        const auto joltage = std::views::iota(0uz, nrLights) |
+                             std::views::transform([&rng](auto) { return uniform(rng, 1, 300); }) |
+                             std::ranges::to<std::vector>();
+        line += std::format(" {{{}}}", join(joltage));
+        std::println("{}", line);
+    }
+}
+
+// size: devices, width: extra branches (the number of paths grows exponentially with it)
+void generateDay11(Rng& rng, Options options) {
+    static constexpr auto maxDevices = std::size_t{26 * 26 * 26 - 2};
+    static constexpr auto window = std::size_t{8};
+
+    const auto nrDevices = std::clamp(options.size, 1uz, maxDevices);
+    const auto nrBranches = (options.width == 0) ? 16 : options.width;
+
+    const auto names = [&] {
+        auto result = std::vector<std::string>{"you"};
+        for (auto i = 0uz; result.size() < nrDevices; ++i) {
+            auto name = std::string{static_cast<char>('a' + (i / 676)), static_cast<char>('a' + ((i / 26) % 26)),
+                                    static_cast<char>('a' + (i % 26))};
+            if ((name != "you") && (name != "out")) {
+                result.push_back(std::move(name));
+            }
+        }
+        return result;
+    }();
+
+    const auto branchProbability = static_cast<double>(nrBranches) / static_cast<double>(nrDevices);
+
+    for (auto i = 0uz; i < nrDevices; ++i) {
+        auto targets = std::vector<std::string>{};
+        if ((i + 1 == nrDevices) || chance(rng, 0.25)) {
+            targets.push_back("out");
+        }
+        if (i + 1 < nrDevices) {
+            const auto last = std::min(nrDevices - 1, i + window);
+            const auto first = uniform(rng, i + 1, last);
+            targets.push_back(names[first]);
+            if ((first < last) && chance(rng, branchProbability)) {
+                targets.push_back(names[uniform(rng, first + 1, last)]);
+            }
+        }
+
+        std::print("{}:", names[i]);
+        std::ranges::for_each(targets, [](const auto& t) { std::print(" {}", t); });
+        std::println();
+    }
+}
+
+using Generator = void (*)(Rng&, Options);
+
+static constexpr auto generators =
+    std::array<Generator, 11>{generateDay1, generateDay2, generateDay3, generateDay4,  generateDay5, generateDay6,
+                              generateDay7, generateDay8, generateDay9, generateDay10, generateDay11};
+
+int main(int argc, const char** argv) {
+    if (argc < 3) {
+        std::println(stderr, "usage: {} <day> <size> [seed] [width]", argv[0]);
+        return 1;
+    }
+
+    const auto day = parseInt<std::size_t>(argv[1]);
+    assert((day >= 1) && (day <= generators.size()));
+
+    const auto options = Options{.size = parseInt<std::size_t>(argv[2]),
+                                 .width = (argc >= 5) ? parseInt<std::size_t>(argv[4]) : 0};
+    auto rng = Rng{(argc >= 4) ? parseInt<std::uint64_t>(argv[3]) : 0};
+
+    generators[day - 1](rng, options);
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "shared/thread_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Batch evaluation of the safe's dial. A rotation is a signed count: negative turns left, positive turns right. The
+// dial position is a prefix sum modulo 100 and both answers only depend on consecutive positions, so the rotations
+// are evaluated eight at a time with a SIMD prefix sum and in parallel chunks whose start positions come from a scan
+// over the chunks' net displacements.
+namespace day1::dial {
+
+using Rotation = std::int32_t;
+
+inline constexpr auto limit = 100;
+inline constexpr auto start = 50;
+
+struct Result {
+    int location{start};
+    std::uint64_t nrStops{0};   // rotations that end at 0 (part 1)
+    std::uint64_t nrPasses{0};  // times 0 is reached during or at the end of a rotation (part 2)
+};
+
+namespace detail {
+
+inline std::uint32_t magnitude(Rotation rotation) {
+    const auto value = static_cast<std::uint32_t>(rotation);
+    return (rotation < 0) ? 0u - value : value;
+}
+
+inline int step(Rotation rotation) {
+    const auto rest = static_cast<int>(magnitude(rotation) % limit);
+    return ((rotation < 0) && (rest != 0)) ? limit - rest : rest;
+}
+
+inline void turn(Rotation rotation, Result& result) {
+    const auto count = magnitude(rotation);
+    const auto rest = static_cast<int>(count % limit);
+    const auto prev = result.location;
+
+    result.nrPasses += count / limit;
+    if (rotation < 0) {
+        result.nrPasses += (rest == 0) ? (prev == 0) : ((prev > 0) && (rest >= prev));
+    } else {
+        result.nrPasses += (prev + rest >= limit);
+    }
+
+    result.location = (prev + step(rotation)) % limit;
+    result.nrStops += (result.location == 0);
+}
+
+#if defined(__AVX2__)
+// Exact for every unsigned 32-bit lane.
+inline __m256i divide(__m256i x) {
+    const auto magic = _mm256_set1_epi32(1374389535);
+    const auto even = _mm256_srli_epi64(_mm256_mul_epu32(x, magic), 37);
+    const auto odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), magic), 37);
+    return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010);
+}
+
+// Exact for lanes below 43699.
+inline __m256i modulo(__m256i x) {
+    const auto q = _mm256_srli_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32(5243)), 19);
+    return _mm256_sub_epi32(x, _mm256_mullo_epi32(q, _mm256_set1_epi32(limit)));
+}
+
+inline __m256i prefixSum(__m256i x) {
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+    return _mm256_add_epi32(x, _mm256_shuffle_epi32(_mm256_permute2x128_si256(x, x, 0x08), 0xff));
+}
+
+inline __m256i broadcastLast(__m256i x) { return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7)); }
+
+struct Block {
+    __m256i negative;
+    __m256i quotient;
+    __m256i rest;
+    __m256i step;
+};
+
+inline Block load(const Rotation* p) {
+    const auto rotations = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const auto negative = _mm256_cmpgt_epi32(_mm256_setzero_si256(), rotations);
+    const auto count = _mm256_abs_epi32(rotations);
+    const auto quotient = divide(count);
+    const auto rest = _mm256_sub_epi32(count, _mm256_mullo_epi32(quotient, _mm256_set1_epi32(limit)));
+    const auto back = modulo(_mm256_sub_epi32(_mm256_set1_epi32(limit), rest));
+    return Block{
+        .negative = negative, .quotient = quotient, .rest = rest, .step = _mm256_blendv_epi8(rest, back, negative)};
+}
+#endif
+
+// Net displacement of the rotations, modulo 100.
+inline int displacement(std::span<const Rotation> rotations) {
+    auto i = std::size_t{0};
+    auto result = 0;
+
+#if defined(__AVX2__)
+    auto sum = _mm256_setzero_si256();
+    for (; i + 8 <= rotations.size(); i += 8) {
+        sum = modulo(_mm256_add_epi32(sum, load(rotations.data() + i).step));
+    }
+    result = _mm256_extract_epi32(modulo(broadcastLast(prefixSum(sum))), 0);
+#endif
+
+    for (; i < rotations.size(); ++i) {
+        result = (result + step(rotations[i])) % limit;
+    }
+    return result;
+}
+
+inline Result evaluate(std::span<const Rotation> rotations, int location) {
+    auto i = std::size_t{0};
+    auto result = Result{.location = location};
+
+#if defined(__AVX2__)
+    const auto zero = _mm256_setzero_si256();
+    auto current = _mm256_set1_epi32(location);
+    auto passes = zero;
+    for (; i + 8 <= rotations.size(); i += 8) {
+        const auto block = load(rotations.data() + i);
+        const auto sum = _mm256_add_epi32(current, prefixSum(block.step));
+        const auto next = modulo(sum);
+        const auto prev = modulo(_mm256_sub_epi32(sum, block.step));
+
+        const auto stops = _mm256_cmpeq_epi32(next, zero);
+        result.nrStops += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(stops))));
+
+        // Left: a nonzero rest reaches 0 from any nonzero start it is at least as large as; a zero rest only counts
+        // when it starts at 0. Right: the rest carries past 99.
+        const auto skip = _mm256_or_si256(_mm256_cmpgt_epi32(prev, block.rest),
+                                          _mm256_andnot_si256(_mm256_cmpeq_epi32(block.rest, zero),
+                                                              _mm256_cmpeq_epi32(prev, zero)));
+        const auto left = _mm256_andnot_si256(skip, _mm256_set1_epi32(-1));
+        const auto right = _mm256_cmpgt_epi32(_mm256_add_epi32(prev, block.rest), _mm256_set1_epi32(limit - 1));
+        const auto hits = _mm256_blendv_epi8(right, left, block.negative);
+        const auto total = _mm256_sub_epi32(block.quotient, hits);
+        passes = _mm256_add_epi64(passes, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(total)));
+        passes = _mm256_add_epi64(passes, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(total, 1)));
+
+        current = broadcastLast(next);
+    }
+    result.location = _mm256_extract_epi32(current, 0);
+    result.nrPasses += static_cast<std::uint64_t>(_mm256_extract_epi64(passes, 0) + _mm256_extract_epi64(passes, 1) +
+                                                  _mm256_extract_epi64(passes, 2) + _mm256_extract_epi64(passes, 3));
+#endif
+
+    for (; i < rotations.size(); ++i) {
+        turn(rotations[i], result);
+    }
+    return result;
+}
+
+}  // namespace detail
+
+// Turns the dial from where previous rotations left it and adds their counts, so a long list can be evaluated in
+// batches.
+inline Result turnAll(std::span<const Rotation> rotations, const Result& previous = Result{}) {
+    static constexpr auto minChunkSize = std::size_t{1} << 16;
+
+    const auto nrChunks = std::clamp<std::size_t>(rotations.size() / minChunkSize, 1, ThreadPool::instance().size());
+    const auto chunkSize = (rotations.size() + nrChunks - 1) / nrChunks;
+    const auto chunk = [&](std::size_t i) {
+        const auto first = std::min(i * chunkSize, rotations.size());
+        return rotations.subspan(first, std::min(chunkSize, rotations.size() - first));
+    };
+
+    auto starts = std::vector<int>(nrChunks, previous.location);
+    {
+        auto group = TaskGroup{};
+        for (auto i = std::size_t{1}; i < nrChunks; ++i) {
+            group.run([&starts, &chunk, i] { starts[i] = detail::displacement(chunk(i - 1)); });
+        }
+    }
+    for (auto i = std::size_t{1}; i < nrChunks; ++i) {
+        starts[i] = (starts[i - 1] + starts[i]) % limit;
+    }
+
+    auto results = std::vector<Result>(nrChunks);
+    {
+        auto group = TaskGroup{};
+        for (auto i = std::size_t{1}; i < nrChunks; ++i) {
+            group.run([&results, &starts, &chunk, i] { results[i] = detail::evaluate(chunk(i), starts[i]); });
+        }
+        results[0] = detail::evaluate(chunk(0), starts[0]);
+    }
+
+    return std::ranges::fold_left(results, previous, [](Result a, const Result& b) {
+        return Result{.location = b.location, .nrStops = a.nrStops + b.nrStops, .nrPasses = a.nrPasses + b.nrPasses};
+    });
+}
+
+// Calls f with consecutive batches of the rotations as they arrive, so a stream is never held in memory as a whole. A
+// batch spans several chunks, so turnAll() still runs in parallel within it.
+template <std::ranges::input_range R, typename F>
+void forEachBatch(R&& rotations, F f) {
+    static constexpr auto batchSize = std::size_t{1} << 20;
+
+    auto batch = std::vector<Rotation>();
+    batch.reserve(batchSize);
+    for (const Rotation rotation : rotations) {
+        batch.push_back(rotation);
+        if (batch.size() == batchSize) {
+            f(std::span<const Rotation>{batch});
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        f(std::span<const Rotation>{batch});
+    }
+}
+
+}  // namespace day1::dial
@@ -1,61 +1,49 @@
+#include "day1/dial.hpp"
+#include "shared/shared.hpp"
+#include "shared/solver.hpp"
+
 #include <algorithm>
 #include <cassert>
 #include <filesystem>
-#include <fstream>
-#include <iostream>
-
-enum class Direction { left, right };
-
-class Safe {
-public:
-    void turn(Direction dir, int count) {
-        assert(count >= 0);
-
-        if (dir == Direction::left) {
-            count %= limit;
-            count = limit - count;
-        }
-
-        location_ += count;
-        location_ %= limit;
+#include <format>
+#include <ranges>
+#include <span>
+#include <string_view>
 
-        if (location_ == 0) {
-            ++nrZeroes_;
-        }
-    }
+namespace day1::part1 {
 
-    int nrZeroes() const { return nrZeroes_; }
+dial::Rotation parseRotation(std::string_view line) {
+    assert(line.size() >= 2);
 
-private:
-    static constexpr auto limit = 100;
+    const auto dirRaw = line[0];
+    assert((dirRaw == 'L') || (dirRaw == 'R'));
 
-    int nrZeroes_ = 0;
-    int location_ = 50;
-};
+    const auto count = parseInt<dial::Rotation>(line.substr(1));
 
-int solve(const std::filesystem::path& path) {
-    auto input = std::ifstream{path};
-    auto safe = Safe{};
-
-    auto line = std::string{};
-    while (std::getline(input, line)) {
-        assert(line.size() >= 2);
-
-        const auto dirRaw = line[0];
-        assert((dirRaw == 'L') || (dirRaw == 'R'));
-        const auto direction = (dirRaw == 'L') ? Direction::left : Direction::right;
+    return (dirRaw == 'L') ? -count : count;
+}
 
-        const auto count = std::atoi(line.c_str() + 1);
+// The rotations are parsed lazily, while solve() turns the dial.
+auto parse(const std::filesystem::path& path) { return streamLines(path) | std::views::transform(parseRotation); }
 
-        safe.turn(direction, count);
-    }
+auto solve(std::ranges::input_range auto&& rotations) {
+    AOC_TIMER("day1.part1.solve");
+    auto result = dial::Result{};
+    dial::forEachBatch(rotations, [&result](std::span<const dial::Rotation> batch) {
+        result = dial::turnAll(batch, result);
+    });
+    return result.nrStops;
+}
 
-    return safe.nrZeroes();
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    return std::format("{}", solve(parse(args[0])));
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
+[[maybe_unused]] const auto registered = registerSolver(1, 1, run);
+
+}  // namespace day1::part1
 
-    const auto path = std::filesystem::path{argv[1]};
-    std::cout << solve(path) << '\n';
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day1::part1::run); }
+#endif
\ No newline at end of file
@@ -1,8 +1,17 @@
+#include "day1/dial.hpp"
+#include "shared/shared.hpp"
+#include "shared/solver.hpp"
+
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <filesystem>
-#include <fstream>
-#include <print>
+#include <format>
+#include <ranges>
+#include <span>
+#include <string_view>
+
+namespace day1::part2 {
 
 enum class Direction { left, right };
 
@@ -49,33 +58,64 @@ private:
     int prevLocation_ = location_;
 };
 
-int solve(const std::filesystem::path& path) {
-    auto input = std::ifstream{path};
-    auto safe = Safe{};
+dial::Rotation parseRotation(std::string_view line) {
+    assert(line.size() >= 2);
+
+    const auto dirRaw = line[0];
+    assert((dirRaw == 'L') || (dirRaw == 'R'));
 
-    auto line = std::string{};
-    while (std::getline(input, line)) {
-        assert(line.size() >= 2);
+    const auto count = parseInt<dial::Rotation>(line.substr(1));
 
-        const auto dirRaw = line[0];
-        assert((dirRaw == 'L') || (dirRaw == 'R'));
-        const auto direction = (dirRaw == 'L') ? Direction::left : Direction::right;
+    return (dirRaw == 'L') ? -count : count;
+}
 
-        const auto count = std::atoi(line.c_str() + 1);
+// The rotations are parsed lazily, while solve() turns the dial.
+auto parse(const std::filesystem::path& path) { return streamLines(path) | std::views::transform(parseRotation); }
 
-        const auto prev = safe.location();
+// Replays the rotations one at a time to record every intermediate state. The log and the safe live across batches.
+class Tracer {
+public:
+    void replay([[maybe_unused]] std::span<const dial::Rotation> rotations) {
+#ifdef AOC_TRACE
+        for (const auto rotation : rotations) {
+            const auto prev = safe_.location();
+            const auto direction = (rotation < 0) ? Direction::left : Direction::right;
+            const auto count = std::abs(rotation);
 
-        safe.turn(direction, count);
+            safe_.turn(direction, count);
 
-        std::println("{} \t+ {} \t= {} \t{}", prev, line, safe.location(), safe.nrZeroes());
+            AOC_TRACE_ROW(log_, prev, (rotation < 0) ? 'L' : 'R', count, safe_.location(), safe_.nrZeroes());
+        }
+#endif
     }
 
-    return safe.nrZeroes();
+#ifdef AOC_TRACE
+private:
+    Safe safe_;
+    instrument::TraceLog<int, char, int, int, int> log_{"day1.part2"};
+#endif
+};
+
+auto solve(std::ranges::input_range auto&& rotations) {
+    AOC_TIMER("day1.part2.solve");
+    auto tracer = Tracer{};
+    auto result = dial::Result{};
+    dial::forEachBatch(rotations, [&tracer, &result](std::span<const dial::Rotation> batch) {
+        tracer.replay(batch);
+        result = dial::turnAll(batch, result);
+    });
+    return result.nrPasses;
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    return std::format("{}", solve(parse(args[0])));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(1, 2, run);
+
+}  // namespace day1::part2
 
-    const auto path = std::filesystem::path{argv[1]};
-    std::println("{}", solve(path));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day1::part2::run); }
+#endif
\ No newline at end of file
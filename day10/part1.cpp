@@ -1,12 +1,22 @@
+#include "shared/cache.hpp"
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <filesystem>
+#include <format>
 #include <functional>
+#include <generator>
+#include <memory_resource>
 #include <print>
+#include <tuple>
 #include <vector>
 
+namespace day10::part1 {
+
 enum class Light { off, on };
 
 bool isEven(int i) { return i % 2 == 0; }
@@ -20,22 +30,26 @@ Light operator*(Light l, int i) {
 
 Light operator+(Light a, Light b) { return (a == b) ? Light::off : Light::on; }
 
-using IndicatorLightDiagram = std::vector<Light>;
+using IndicatorLightDiagram = std::pmr::vector<Light>;
 
-using WiringSchematic = std::vector<int>;
-using WiringSchematics = std::vector<WiringSchematic>;
+using WiringSchematic = std::pmr::vector<int>;
+using WiringSchematics = std::pmr::vector<WiringSchematic>;
 
-using JoltageRequirements = std::vector<int>;
+using JoltageRequirements = std::pmr::vector<int>;
 
 struct Machine {
     IndicatorLightDiagram lights;
     WiringSchematics wiring;
     JoltageRequirements joltage;
+
+    auto members() const { return std::tie(lights, wiring, joltage); }
 };
 
-using Machines = std::vector<Machine>;
+using Machines = std::pmr::vector<Machine>;
 
-IndicatorLightDiagram makeIndicatorLightDiagram(std::size_t size) { return IndicatorLightDiagram(size, Light::off); }
+IndicatorLightDiagram makeIndicatorLightDiagram(std::size_t size, std::pmr::memory_resource* resource) {
+    return IndicatorLightDiagram(size, Light::off, resource);
+}
 
 IndicatorLightDiagram add(IndicatorLightDiagram a, const IndicatorLightDiagram& b) {
     assert(a.size() == b.size());
@@ -43,9 +57,10 @@ IndicatorLightDiagram add(IndicatorLightDiagram a, const IndicatorLightDiagram&
     return a;
 }
 
-IndicatorLightDiagram multiply(std::size_t size, const WiringSchematic& schematic, int factor) {
+IndicatorLightDiagram multiply(std::size_t size, const WiringSchematic& schematic, int factor,
+                               std::pmr::memory_resource* resource) {
     const auto diagram = [&]() {
-        auto result = makeIndicatorLightDiagram(size);
+        auto result = makeIndicatorLightDiagram(size, resource);
         std::ranges::for_each(schematic, [&result](auto i) {
             assert((i >= 0) && std::cmp_less(i, result.size()));
             result[i] = Light::on;
@@ -53,10 +68,11 @@ IndicatorLightDiagram multiply(std::size_t size, const WiringSchematic& schemati
         return result;
     }();
 
-    return diagram | std::views::transform([factor](auto i) { return i * factor; }) | std::ranges::to<std::vector>();
+    return diagram | std::views::transform([factor](auto i) { return i * factor; }) |
+           std::ranges::to<IndicatorLightDiagram>(resource);
 }
 
-IndicatorLightDiagram parseIndicatorLightDiagram(std::string_view str) {
+IndicatorLightDiagram parseIndicatorLightDiagram(std::string_view str, std::pmr::memory_resource* resource) {
     assert(str.size() >= 3);
     assert(str.front() == '[');
     assert(str.back() == ']');
@@ -70,10 +86,10 @@ IndicatorLightDiagram parseIndicatorLightDiagram(std::string_view str) {
         return (c == '.') ? Light::off : Light::on;
     };
 
-    return str | std::views::transform(parseLight) | std::ranges::to<std::vector>();
+    return str | std::views::transform(parseLight) | std::ranges::to<IndicatorLightDiagram>(resource);
 }
 
-WiringSchematic parseWiringSchematic(std::string_view str) {
+WiringSchematic parseWiringSchematic(std::string_view str, std::pmr::memory_resource* resource) {
     assert(str.size() >= 3);
     assert(str.front() == '(');
     assert(str.back() == ')');
@@ -82,10 +98,10 @@ WiringSchematic parseWiringSchematic(std::string_view str) {
     str.remove_suffix(1);
 
     return str | std::views::split(',') | as<std::string_view>() | std::views::transform(parseInt<int>) |
-           std::ranges::to<std::vector>();
+           std::ranges::to<WiringSchematic>(resource);
 }
 
-JoltageRequirements parseJoltageRequirements(std::string_view str) {
+JoltageRequirements parseJoltageRequirements(std::string_view str, std::pmr::memory_resource* resource) {
     assert(str.size() >= 3);
     assert(str.front() == '{');
     assert(str.back() == '}');
@@ -94,24 +110,26 @@ JoltageRequirements parseJoltageRequirements(std::string_view str) {
     str.remove_suffix(1);
 
     return str | std::views::split(',') | as<std::string_view>() | std::views::transform(parseInt<int>) |
-           std::ranges::to<std::vector>();
+           std::ranges::to<JoltageRequirements>(resource);
 }
 
-Machine parseMachine(std::string_view str) {
+Machine parseMachine(std::string_view str, std::pmr::memory_resource* resource) {
     const auto parts = str | std::views::split(' ') | as<std::string_view>() | std::ranges::to<std::vector>();
 
     assert(parts.size() >= 3);
 
-    auto lights = parseIndicatorLightDiagram(parts.front());
-    auto wiring = std::span{parts}.subspan(1, parts.size() - 2) | std::views::transform(parseWiringSchematic) |
-                  std::ranges::to<std::vector>();
-    auto joltage = parseJoltageRequirements(parts.back());
+    auto lights = parseIndicatorLightDiagram(parts.front(), resource);
+    auto wiring = std::span{parts}.subspan(1, parts.size() - 2) |
+                  std::views::transform([resource](auto part) { return parseWiringSchematic(part, resource); }) |
+                  std::ranges::to<WiringSchematics>(resource);
+    auto joltage = parseJoltageRequirements(parts.back(), resource);
 
-    return Machine{lights, wiring, joltage};
+    return Machine{std::move(lights), std::move(wiring), std::move(joltage)};
 }
 
-Machines parse(const std::filesystem::path& path) {
-    return yieldLines(path) | std::views::transform(parseMachine) | std::ranges::to<std::vector>();
+Machines parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day10.part1.parse");
+    return cache::load(path, "machines", arena, [&] { return parseLinesParallel(path, arena, parseMachine); });
 }
 
 using Selection = std::span<const int>;
@@ -131,19 +149,27 @@ std::generator<Selection> yieldSelections(std::size_t size) {
     const auto isDone = [&data]() { return std::ranges::all_of(data, [](auto i) { return i == 1; }); };
 
     while (!isDone()) {
+        AOC_COUNT("day10.part1.selections", 1);
         co_yield data;
         next();
     }
 }
 
 auto solve(const Machines& machines) {
+    AOC_TIMER("day10.part1.solve");
     static constexpr auto impl = [](const Machine& machine) {
         const auto isValid = [&machine](Selection selection) {
+            // The diagrams of one selection are short-lived, so they live in a stack buffer.
+            std::array<std::byte, 4096> buffer;
+            auto scratch = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size()};
+
             const auto& target = machine.lights;
             const auto size = target.size();
-            const auto mul = std::bind_front(multiply, size);
+            const auto mul = [size, &scratch](const auto& schematic, int factor) {
+                return multiply(size, schematic, factor, &scratch);
+            };
             const auto result = std::ranges::fold_left(std::views::zip_transform(mul, machine.wiring, selection),
-                                                       makeIndicatorLightDiagram(size), add);
+                                                       makeIndicatorLightDiagram(size, &scratch), add);
 
             return target == result;
         };
@@ -156,10 +182,18 @@ auto solve(const Machines& machines) {
     return std::ranges::fold_left(machines | std::views::transform(impl), 0, std::plus<>{});
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto problem = parse(path);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto problem = parse(args[0], arena);
+
+    return std::format("{}", solve(problem));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(10, 1, run);
+
+}  // namespace day10::part1
 
-    std::println("{}", solve(problem));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day10::part1::run); }
+#endif
\ No newline at end of file
@@ -1,29 +1,34 @@
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <cassert>
 #include <cmath>
 #include <filesystem>
+#include <format>
 #include <functional>
 #include <map>
+#include <memory_resource>
 #include <print>
 #include <regex>
 #include <vector>
 
+namespace day11::part1 {
+
 struct Device {
     std::string name;
 
     constexpr auto operator<=>(const Device&) const noexcept = default;
 };
 
-using Devices = std::vector<Device>;
+using Devices = std::pmr::vector<Device>;
 
-using Connections = std::map<Device, Devices>;
+using Connections = std::pmr::map<Device, Devices>;
 
 struct Rack {
     Connections connections;
 };
 
-std::pair<const Device, Devices> parseConnection(std::string_view str) {
+std::pair<const Device, Devices> parseConnection(std::string_view str, std::pmr::memory_resource* resource) {
     static const auto fullRegex = std::regex{"([[:alpha:]]{3}):( ([[:alpha:]]{3}))+"};
     assert(std::regex_match(str.begin(), str.end(), fullRegex));
 
@@ -38,21 +43,22 @@ std::pair<const Device, Devices> parseConnection(std::string_view str) {
     const auto device = toDevice(*iter);
 
     ++iter;
-    const auto devices =
-        std::ranges::subrange(iter, end) | std::views::transform(toDevice) | std::ranges::to<std::vector>();
+    auto devices =
+        std::ranges::subrange(iter, end) | std::views::transform(toDevice) | std::ranges::to<Devices>(resource);
     assert(!devices.empty());
 
-    return {device, devices};
+    return {device, std::move(devices)};
 }
 
-Rack parse(const std::filesystem::path& path) {
-    auto result = Rack{};
-    std::ranges::transform(yieldLines(path), std::inserter(result.connections, result.connections.begin()),
-                           parseConnection);
-    return result;
+Rack parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day11.part1.parse");
+    auto connections = parseLinesParallel(path, arena, parseConnection);
+    return Rack{.connections{std::make_move_iterator(connections.begin()), std::make_move_iterator(connections.end()),
+                             arena.resource()}};
 }
 
 auto solve(const Rack& rack) {
+    AOC_TIMER("day11.part1.solve");
     static const auto start = Device{.name = "you"};
     static const auto goal = Device{.name = "out"};
 
@@ -95,10 +101,18 @@ auto solve(const Rack& rack) {
     return count;
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto problem = parse(path);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto problem = parse(args[0], arena);
+
+    return std::format("{}", solve(problem));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(11, 1, run);
+
+}  // namespace day11::part1
 
-    std::println("{}", solve(problem));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day11::part1::run); }
+#endif
\ No newline at end of file
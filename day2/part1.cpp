@@ -1,39 +1,36 @@
+#include "day2/repeats.hpp"
+#include "shared/shared.hpp"
+#include "shared/solver.hpp"
+
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <filesystem>
-#include <fstream>
+#include <format>
 #include <functional>
 #include <print>
 #include <ranges>
 #include <string>
+#include <vector>
+
+namespace day2::part1 {
 
 using T = std::uint64_t;
 
 class Id {
 public:
     Id() = default;
-    explicit Id(T val) : str_{std::to_string(val)}, val_{val} {}
-    explicit Id(std::string_view str) : str_{str}, val_{std::stoull(str_)} {}
+    explicit Id(T val) : val_{val} {}
+    explicit Id(std::string_view str) : val_{parseInt<T>(str)} {}
 
+    // An even number of digits whose halves are equal.
     bool isValid() const {
-        const auto str = std::string_view{str_};
-        const auto strSize = str.size();
-        const auto strSizeIsEven = (strSize % 2) == 0;
-
-        if (!strSizeIsEven) {
-            return true;
-        }
-
-        const auto front = str_.substr(0, strSize / 2);
-        const auto back = str_.substr(strSize / 2);
-
-        return front != back;
+        const auto length = repeats::nrDigits(val_);
+        return ((length % 2) != 0) || ((val_ % repeats::factor(length, length / 2)) != 0);
     }
 
     Id& operator++() {
         ++val_;
-        str_ = std::to_string(val_);
         return *this;
     }
 
@@ -51,7 +48,6 @@ public:
     T value() const { return val_; }
 
 private:
-    std::string str_{"0"};
     T val_{0};
 };
 
@@ -80,29 +76,36 @@ auto elem(R&& range, int index) {
 }
 
 T sumRange(std::string_view str) {
-    const auto range = [str]() {
-        auto items = str | split('-') | to<Id>{};
-        const auto from = elem(items, 0);
-        const auto to = elem(items, 1);
-        return std::views::iota(from, to + 1);
-    }();
-
-    return sum(range | std::views::transform(valueIfValid));
+    auto items = str | split('-') | to<Id>{};
+    const auto from = elem(items, 0).value();
+    const auto to = elem(items, 1).value();
+
+    // Invalid ids are an even number of digits whose halves are equal.
+    auto result = repeats::Wide{0};
+    for (auto length = 2; length <= repeats::maxDigits; length += 2) {
+        result += repeats::sumRepeated(from, to, length, length / 2);
+    }
+    return static_cast<T>(result);
 }
 
 T solve(const std::filesystem::path& path) {
-    const auto input = [&path]() {
-        auto stream = std::ifstream{path};
-        auto string = std::string{};
-        std::getline(stream, string);
-        return string;
-    }();
-
-    return sum(input | split(',') | std::views::transform(sumRange));
+    AOC_TIMER("day2.part1.solve");
+    const auto lines = yieldLines(path);
+    assert(!lines.empty());
+    const auto input = lines.front();
+
+    return repeats::sumRanges(input | split(',') | std::ranges::to<std::vector>(), sumRange);
+}
+
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    return std::format("{}", solve(args[0]));
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    std::println("{}", solve(path));
-}
\ No newline at end of file
+[[maybe_unused]] const auto registered = registerSolver(2, 1, run);
+
+}  // namespace day2::part1
+
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day2::part1::run); }
+#endif
\ No newline at end of file
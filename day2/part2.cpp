@@ -1,12 +1,23 @@
+#include "day2/repeats.hpp"
+#include "shared/shared.hpp"
+#include "shared/solver.hpp"
+
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
-#include <fstream>
+#include <format>
 #include <functional>
 #include <print>
 #include <ranges>
+#include <span>
 #include <string>
+#include <vector>
+
+namespace day2::part2 {
 
 using T = std::uint64_t;
 
@@ -21,26 +32,22 @@ auto operator|(R&& range, to<T>) {
 class Id {
 public:
     Id() = default;
-    explicit Id(T val) : str_{std::to_string(val)}, val_{val} {}
-    explicit Id(std::string_view str) : str_{str}, val_{std::stoull(str_)} {}
+    explicit Id(T val) : val_{val} {}
+    explicit Id(std::string_view str) : val_{parseInt<T>(str)} {}
 
+    // A block repeated at least twice.
     bool isValid() const {
-        const auto str = std::string_view{str_};
-        const auto size = str.size();
-
-        for (auto i : std::views::iota(1uz, (size / 2) + 1)) {
-            auto parts = str | std::views::chunk(i) | to<std::string_view>{} | std::views::pairwise;
-            if (std::ranges::all_of(parts, [](const auto& p) { return std::apply(std::equal_to<>(), p); })) {
+        const auto length = repeats::nrDigits(val_);
+        for (auto blockLength = 1; blockLength <= length / 2; ++blockLength) {
+            if ((length % blockLength == 0) && (val_ % repeats::factor(length, blockLength) == 0)) {
                 return false;
             }
         }
-
         return true;
     }
 
     Id& operator++() {
         ++val_;
-        str_ = std::to_string(val_);
         return *this;
     }
 
@@ -58,7 +65,6 @@ public:
     T value() const { return val_; }
 
 private:
-    std::string str_{"0"};
     T val_{0};
 };
 
@@ -78,30 +84,87 @@ auto elem(R&& range, int index) {
     return *result;
 }
 
+// Invalid ids repeat a block whose length is a proper divisor of their length. Every such divisor divides length / p
+// for some prime p, so the union over those primes is summed with inclusion-exclusion: ids that repeat blocks of
+// length / p and length / q repeat blocks of length / (p * q). The terms only depend on the length, so they are
+// computed once for every length.
+struct Term {
+    int blockLength{0};
+    int sign{0};
+};
+
+struct Terms {
+    std::array<Term, 3> terms{};  // lengths up to 20 have at most two distinct prime factors
+    std::size_t size{0};
+};
+
+static constexpr auto inclusionExclusion = [] {
+    auto result = std::array<Terms, repeats::maxDigits + 1>{};
+    for (auto length = 2; length <= repeats::maxDigits; ++length) {
+        auto primes = std::array<int, 2>{};
+        auto nrPrimes = 0uz;
+        for (auto n = length, p = 2; n > 1; ++p) {
+            if (n % p == 0) {
+                primes[nrPrimes++] = p;
+                while (n % p == 0) {
+                    n /= p;
+                }
+            }
+        }
+
+        auto& terms = result[length];
+        for (auto subset = 1u; subset < (1u << nrPrimes); ++subset) {
+            auto blockLength = length;
+            for (auto i = 0uz; i < nrPrimes; ++i) {
+                if ((subset & (1u << i)) != 0) {
+                    blockLength /= primes[i];
+                }
+            }
+            const auto sign = (std::popcount(subset) % 2 == 1) ? 1 : -1;
+            terms.terms[terms.size++] = Term{.blockLength = blockLength, .sign = sign};
+        }
+    }
+    return result;
+}();
+
 T sumRange(std::string_view str) {
-    const auto range = [str]() {
-        auto items = str | split('-') | to<Id>{};
-        const auto from = elem(items, 0);
-        const auto to = elem(items, 1);
-        return std::views::iota(from, to + 1);
-    }();
-
-    return sum(range | std::views::transform(valueIfValid));
+    auto items = str | split('-') | to<Id>{};
+    const auto from = elem(items, 0).value();
+    const auto to = elem(items, 1).value();
+
+    auto result = repeats::Wide{0};
+    for (auto length = 2; length <= repeats::maxDigits; ++length) {
+        const auto& terms = inclusionExclusion[length];
+        for (const auto& term : std::span{terms.terms}.first(terms.size)) {
+            const auto termSum = repeats::sumRepeated(from, to, length, term.blockLength);
+            if (term.sign > 0) {
+                result += termSum;
+            } else {
+                result -= termSum;
+            }
+        }
+    }
+    return static_cast<T>(result);
 }
 
 T solve(const std::filesystem::path& path) {
-    const auto input = [&path]() {
-        auto stream = std::ifstream{path};
-        auto string = std::string{};
-        std::getline(stream, string);
-        return string;
-    }();
-
-    return sum(input | split(',') | std::views::transform(sumRange));
+    AOC_TIMER("day2.part2.solve");
+    const auto lines = yieldLines(path);
+    assert(!lines.empty());
+    const auto input = lines.front();
+
+    return repeats::sumRanges(input | split(',') | std::ranges::to<std::vector>(), sumRange);
+}
+
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    return std::format("{}", solve(args[0]));
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    std::println("{}", solve(path));
-}
\ No newline at end of file
+[[maybe_unused]] const auto registered = registerSolver(2, 2, run);
+
+}  // namespace day2::part2
+
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day2::part2::run); }
+#endif
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+namespace day3::bank {
+
+using Digit = std::uint8_t;
+
+__extension__ using Wide = unsigned __int128;
+
+// Digits of the largest number that keeps K of the digits in str, in their original order. A single pass with a
+// monotonic stack: a digit evicts smaller digits before it as long as enough digits remain to fill all K places.
+template <std::size_t K>
+std::array<Digit, K> largestDigits(std::string_view str) {
+    assert(str.size() >= K);
+
+    auto result = std::array<Digit, K>{};
+    auto size = std::size_t{0};
+    auto drops = str.size() - K;
+
+    for (const auto c : str) {
+        assert((c >= '0') && (c <= '9'));
+        const auto digit = static_cast<Digit>(c - '0');
+
+        while ((size > 0) && (drops > 0) && (result[size - 1] < digit)) {
+            --size;
+            --drops;
+        }
+
+        if (size < K) {
+            result[size++] = digit;
+        } else {
+            --drops;
+        }
+    }
+
+    return result;
+}
+
+// Unsigned integer of N 64-bit limbs, least significant first. It lives entirely in its array, so results that do not
+// fit in 64 bits stay free of heap allocations.
+template <std::size_t N>
+class UInt {
+public:
+    constexpr UInt() = default;
+    constexpr explicit UInt(std::uint64_t value) : limbs_{value} {}
+
+    // *this = *this * factor + addend
+    constexpr UInt& multiplyAdd(std::uint64_t factor, std::uint64_t addend) {
+        auto carry = addend;
+        for (auto& limb : limbs_) {
+            const auto product = (static_cast<Wide>(limb) * factor) + carry;
+            limb = static_cast<std::uint64_t>(product);
+            carry = static_cast<std::uint64_t>(product >> 64);
+        }
+        assert(carry == 0);
+        return *this;
+    }
+
+    // Divides by divisor and returns the remainder.
+    constexpr std::uint64_t divide(std::uint64_t divisor) {
+        auto remainder = std::uint64_t{0};
+        for (auto& limb : limbs_ | std::views::reverse) {
+            const auto dividend = (static_cast<Wide>(remainder) << 64) | limb;
+            limb = static_cast<std::uint64_t>(dividend / divisor);
+            remainder = static_cast<std::uint64_t>(dividend % divisor);
+        }
+        return remainder;
+    }
+
+    constexpr UInt& operator+=(const UInt& rhs) {
+        auto carry = std::uint64_t{0};
+        for (auto i = std::size_t{0}; i < N; ++i) {
+            const auto overflow1 = __builtin_add_overflow(limbs_[i], rhs.limbs_[i], &limbs_[i]);
+            const auto overflow2 = __builtin_add_overflow(limbs_[i], carry, &limbs_[i]);
+            carry = (overflow1 || overflow2) ? 1 : 0;
+        }
+        assert(carry == 0);
+        return *this;
+    }
+
+    friend constexpr UInt operator+(UInt lhs, const UInt& rhs) { return lhs += rhs; }
+
+    constexpr bool operator==(const UInt&) const = default;
+
+    constexpr bool isZero() const { return std::ranges::all_of(limbs_, [](auto limb) { return limb == 0; }); }
+
+    std::string toString() const {
+        static constexpr auto chunkSize = std::uint64_t{10'000'000'000'000'000'000u};
+
+        auto rest = *this;
+        auto chunks = std::array<std::uint64_t, (2 * N) + 1>{};
+        auto nrChunks = std::size_t{0};
+        do {
+            chunks[nrChunks++] = rest.divide(chunkSize);
+        } while (!rest.isZero());
+
+        auto result = std::format("{}", chunks[nrChunks - 1]);
+        for (auto i = nrChunks - 1; i-- > 0;) {
+            result += std::format("{:019}", chunks[i]);
+        }
+        return result;
+    }
+
+private:
+    std::array<std::uint64_t, N> limbs_{};
+};
+
+// Enough limbs for a number of the given digits plus 32 bits of headroom for summing such numbers.
+constexpr std::size_t limbsFor(std::size_t digits) {
+    const auto bits = ((digits * 33220) + 9999) / 10000;
+    return (bits + 32 + 63) / 64;
+}
+
+template <std::size_t Digits>
+using Number = UInt<limbsFor(Digits)>;
+
+// The largest number that keeps K of the digits in str. Digits are combined 19 at a time in one limb before they are
+// shifted into the result.
+template <std::size_t K>
+Number<K> largest(std::string_view str) {
+    static constexpr auto chunkSize = std::size_t{19};
+    static constexpr auto powersOfTen = [] {
+        auto result = std::array<std::uint64_t, chunkSize + 1>{1};
+        for (auto i = std::size_t{1}; i < result.size(); ++i) {
+            result[i] = result[i - 1] * 10;
+        }
+        return result;
+    }();
+
+    const auto digits = largestDigits<K>(str);
+
+    auto result = Number<K>{};
+    for (auto first = std::size_t{0}; first < K; first += chunkSize) {
+        const auto last = std::min(K, first + chunkSize);
+        auto chunk = std::uint64_t{0};
+        for (auto i = first; i < last; ++i) {
+            chunk = (chunk * 10) + digits[i];
+        }
+        result.multiplyAdd(powersOfTen[last - first], chunk);
+    }
+
+    return result;
+}
+
+}  // namespace day3::bank
+
+template <std::size_t N>
+struct std::formatter<day3::bank::UInt<N>> : std::formatter<std::string> {
+    auto format(const day3::bank::UInt<N>& value, std::format_context& context) const {
+        return std::formatter<std::string>::format(value.toString(), context);
+    }
+};
@@ -1,45 +1,40 @@
+#include "day3/bank.hpp"
+#include "shared/shared.hpp"
+#include "shared/solver.hpp"
+
 #include <algorithm>
 #include <cassert>
 #include <filesystem>
-#include <fstream>
-#include <generator>
+#include <format>
 #include <print>
 
-using T = std::uint64_t;
+namespace day3::part1 {
+
+static constexpr auto digits = 2uz;
+
+using T = bank::Number<digits>;
 
 template <typename R>
 T sum(R&& range) {
     return std::ranges::fold_left(std::forward<R>(range), T{0}, std::plus<T>{});
 }
 
-std::generator<std::string_view> read(const std::filesystem::path& path) {
-    auto input = std::ifstream{path};
-    auto line = std::string{};
-    while (std::getline(input, line)) {
-        co_yield line;
-    }
-}
+T fixBank(std::string_view str) { return bank::largest<digits>(str); }
 
-T ctoi(char c) {
-    auto result = T{};
-    std::from_chars<T>(&c, &c + 1, result);
-    return result;
+T solve(const std::filesystem::path& path) {
+    AOC_TIMER("day3.part1.solve");
+    return sum(streamLines(path) | std::views::transform(fixBank));
 }
 
-T fixBank(std::string_view str) {
-    assert(str.size() >= 2);
-    assert(str.find_first_not_of("0123456789") == std::string_view::npos);
-
-    const auto it1 = std::ranges::max_element(str.begin(), std::prev(str.end()), {}, ctoi);
-    const auto it2 = std::ranges::max_element(std::next(it1), str.end(), {}, ctoi);
-
-    return (ctoi(*it1) * 10) + ctoi(*it2);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    return std::format("{}", solve(args[0]));
 }
 
-T solve(const std::filesystem::path& path) { return sum(read(path) | std::views::transform(fixBank)); }
+[[maybe_unused]] const auto registered = registerSolver(3, 1, run);
+
+}  // namespace day3::part1
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    std::println("{}", solve(path));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day3::part1::run); }
+#endif
\ No newline at end of file
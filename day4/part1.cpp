@@ -1,77 +1,20 @@
+#include "day4/grid.hpp"
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <cassert>
-#include <cstdint>
 #include <filesystem>
-#include <functional>
+#include <format>
 #include <print>
-#include <ranges>
 #include <string>
-#include <utility>
-#include <vector>
 
-struct Location {
-    int row{0};
-    int col{0};
-};
+namespace day4::part1 {
 
-struct Offset {
-    int row{0};
-    int col{0};
-};
+using grid::Grid;
 
-struct Size {
-    int rows{0};
-    int cols{0};
-};
-
-bool isValid(Location l, Size s) { return (l.col >= 0) && (l.col < s.cols) && (l.row >= 0) && (l.row < s.rows); }
-
-Location operator+(Location l, Offset o) { return Location{.row = l.row + o.row, .col = l.col + o.col}; }
-
-static constexpr auto neighbors =
-    std::array<Offset, 8>{{{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}}};
-
-auto validNeighbors(Location l, Size s) {
-    return neighbors | std::views::transform([l](auto o) { return l + o; }) |
-           std::views::filter([s](auto l) { return isValid(l, s); });
-}
-
-auto locations(Size s) {
-    return std::views::cartesian_product(std::views::iota(0, s.rows), std::views::iota(0, s.cols)) |
-           std::views::transform([](auto t) { return Location{std::get<0>(t), std::get<1>(t)}; });
-}
-
-class Grid {
-public:
-    void append(std::string_view line) {
-        assert(!line.empty());
-        assert(line.find_first_not_of(".@") == std::string::npos);
-        assert(data_.empty() || (line.size() == data_.front().size()));
-
-        data_.emplace_back(line);
-    }
-
-    Size getSize() const {
-        assert(!data_.empty());
-        return Size{.rows = static_cast<int>(data_.size()), .cols = static_cast<int>(data_.front().size())};
-    }
-
-    char element(Location l) const {
-        assert(!data_.empty());
-        assert(isValid(l, getSize()));
-
-        return data_[l.row][l.col];
-    }
-
-private:
-    std::vector<std::string> data_;
-};
-
-bool isRoll(char c) { return c == '@'; }
-
-auto parse(const std::filesystem::path& path) {
-    auto result = Grid{};
+auto parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day4.part1.parse");
+    auto result = Grid{arena.resource()};
 
     for (auto line : yieldLines(path)) {
         result.append(line);
@@ -81,21 +24,22 @@ auto parse(const std::filesystem::path& path) {
 }
 
 auto solve(const Grid& grid) {
-    const auto element = std::bind_front(&Grid::element, &grid);
-    const auto size = grid.getSize();
+    AOC_TIMER("day4.part1.solve");
+    return grid::accessible(grid).count();
+}
 
-    return std::ranges::count(locations(size) | std::views::transform([&](Location l) {
-                                  return isRoll(element(l)) &&
-                                         std::ranges::count_if(validNeighbors(l, size) | std::views::transform(element),
-                                                               isRoll) < 4;
-                              }),
-                              true);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto grid = parse(args[0], arena);
+
+    return std::format("{}", solve(grid));
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto grid = parse(path);
+[[maybe_unused]] const auto registered = registerSolver(4, 1, run);
+
+}  // namespace day4::part1
 
-    std::println("{}", solve(grid));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day4::part1::run); }
+#endif
\ No newline at end of file
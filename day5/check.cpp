@@ -0,0 +1,85 @@
+#include "day5/fresh.hpp"
+#include "shared/shared.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory_resource>
+#include <print>
+#include <ranges>
+#include <string_view>
+
+// Checks FreshSet's live updates against the coalesced ranges of an input:
+//
+//     ./b day5/check.cpp && build/app day5/input.txt
+//
+// It is not a solver, so the runner and the bench, which build day*/part*.cpp, leave it out.
+
+using day5::fresh::FreshSet;
+using day5::fresh::IdRange;
+using day5::fresh::IdRanges;
+
+IdRanges parse(const std::filesystem::path& path, std::pmr::memory_resource* resource) {
+    return streamLines(path) | std::views::take_while(std::not_fn(&std::string_view::empty)) |
+           std::views::transform([](auto str) { return parseFields<IdRange, 2>(str, '-'); }) |
+           std::ranges::to<IdRanges>(resource);
+}
+
+bool matches(const FreshSet& freshIds, std::uint64_t count, std::size_t size) {
+    return (freshIds.count() == count) && (freshIds.size() == size);
+}
+
+// Every range of the input is inserted as it is. Then every coalesced range is inserted again as two overlapping halves
+// in reverse order, and the upper halves are erased and inserted again.
+bool check(const IdRanges& ranges, std::pmr::memory_resource* resource) {
+    auto coalesced = IdRanges(ranges, resource);
+    day5::fresh::coalesce(coalesced);
+    const auto expected = FreshSet{coalesced, resource};
+
+    auto freshIds = FreshSet{resource};
+    for (const auto range : ranges) {
+        freshIds.insert(range);
+    }
+    if (!matches(freshIds, expected.count(), expected.size())) {
+        return false;
+    }
+
+    const auto middle = [](IdRange range) { return range.start + ((range.end - range.start) / 2); };
+
+    auto halves = FreshSet{resource};
+    for (const auto range : coalesced | std::views::reverse) {
+        halves.insert(IdRange{.start = middle(range), .end = range.end});
+        halves.insert(IdRange{.start = range.start, .end = middle(range)});
+    }
+    if (!matches(halves, expected.count(), expected.size())) {
+        return false;
+    }
+
+    auto remaining = expected.count();
+    for (const auto range : coalesced) {
+        halves.erase(IdRange{.start = middle(range), .end = range.end});
+        remaining -= range.end - middle(range) + 1;
+    }
+    if (halves.count() != remaining) {
+        return false;
+    }
+
+    for (const auto range : coalesced) {
+        halves.insert(IdRange{.start = middle(range), .end = range.end});
+    }
+    return matches(halves, expected.count(), expected.size());
+}
+
+int main(int argc, const char** argv) {
+    auto pool = std::pmr::unsynchronized_pool_resource{};
+    const auto ranges = parse((argc >= 2) ? argv[1] : "-", &pool);
+
+    if (!check(ranges, &pool)) {
+        std::println("FreshSet does not match the coalesced ranges");
+        return 1;
+    }
+
+    std::println("ok: {} ranges", ranges.size());
+    return 0;
+}
\ No newline at end of file
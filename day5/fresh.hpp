@@ -0,0 +1,295 @@
+#pragma once
+
+#include "shared/thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Ranges of fresh ingredient ids. Ranges are inclusive and may overlap; coalesce() turns them into sorted, disjoint
+// ranges with a gap between every two of them, which is what the lookups below work on.
+namespace day5::fresh {
+
+using Id = std::uint64_t;
+
+struct IdRange {
+    Id start{0};
+    Id end{0};
+};
+
+using IdRanges = std::pmr::vector<IdRange>;
+
+namespace detail {
+
+// Merges the ranges of a sorted run that overlap or touch, in place, and returns the size of the result.
+inline std::size_t merge(std::span<IdRange> ranges) {
+    auto size = std::size_t{0};
+    for (const auto range : ranges) {
+        assert(range.start <= range.end);
+        if ((size > 0) && ((range.start <= ranges[size - 1].end) || (range.start - ranges[size - 1].end == 1))) {
+            ranges[size - 1].end = std::max(ranges[size - 1].end, range.end);
+        } else {
+            ranges[size++] = range;
+        }
+    }
+    return size;
+}
+
+inline std::size_t coalesceRun(std::span<IdRange> ranges) {
+    std::ranges::sort(ranges, {}, &IdRange::start);
+    return merge(ranges);
+}
+
+// LSD radix sort on bytes. The histograms of all bytes come from one pass over the ids, and bytes that are the same
+// for every id are skipped.
+inline void radixSort(std::span<Id> ids, std::span<Id> scratch) {
+    assert(scratch.size() == ids.size());
+    static constexpr auto radix = std::size_t{256};
+
+    auto histograms = std::array<std::array<std::size_t, radix>, sizeof(Id)>{};
+    for (const auto id : ids) {
+        for (auto byte = std::size_t{0}; byte < sizeof(Id); ++byte) {
+            ++histograms[byte][(id >> (8 * byte)) & (radix - 1)];
+        }
+    }
+
+    auto from = ids;
+    auto to = scratch;
+    for (auto byte = std::size_t{0}; byte < sizeof(Id); ++byte) {
+        auto& offsets = histograms[byte];
+        if (std::ranges::contains(offsets, ids.size())) {
+            continue;
+        }
+
+        auto offset = std::size_t{0};
+        for (auto& count : offsets) {
+            offset += std::exchange(count, offset);
+        }
+        for (const auto id : from) {
+            to[offsets[(id >> (8 * byte)) & (radix - 1)]++] = id;
+        }
+        std::swap(from, to);
+    }
+
+    if (from.data() != ids.data()) {
+        std::ranges::copy(from, ids.begin());
+    }
+}
+
+}  // namespace detail
+
+// Sorts the ranges and merges the ones that overlap or touch. Large lists are split into one chunk per thread that is
+// sorted and coalesced on its own. The coalesced runs are then merged pairwise, in parallel within each round, and
+// every merged run is coalesced again to join the ranges that crossed the boundary between its two halves.
+inline void coalesce(IdRanges& ranges) {
+    static constexpr auto minChunkSize = std::size_t{1} << 16;
+
+    const auto nrChunks = std::clamp<std::size_t>(ranges.size() / minChunkSize, 1, ThreadPool::instance().size());
+    if (nrChunks == 1) {
+        ranges.resize(detail::coalesceRun(ranges));
+        return;
+    }
+
+    // A run starts at the start of its chunk and never grows past the end of the chunks it covers.
+    struct Run {
+        std::size_t first{0};
+        std::size_t size{0};
+    };
+
+    auto runs = std::vector<Run>(nrChunks);
+    {
+        auto group = TaskGroup{};
+        for (auto i = std::size_t{0}; i < nrChunks; ++i) {
+            runs[i].first = (ranges.size() * i) / nrChunks;
+            const auto last = (ranges.size() * (i + 1)) / nrChunks;
+            group.run([&ranges, &runs, i, last] {
+                runs[i].size = detail::coalesceRun(std::span{ranges}.subspan(runs[i].first, last - runs[i].first));
+            });
+        }
+    }
+
+    auto scratch = IdRanges(ranges.size(), ranges.get_allocator().resource());
+    auto from = std::span{ranges};
+    auto to = std::span{scratch};
+    while (runs.size() > 1) {
+        auto merged = std::vector<Run>((runs.size() + 1) / 2);
+        {
+            auto group = TaskGroup{};
+            for (auto i = std::size_t{0}; i < merged.size(); ++i) {
+                group.run([&runs, &merged, from, to, i] {
+                    const auto& a = runs[2 * i];
+                    const auto out = to.subspan(a.first);
+                    if ((2 * i) + 1 == runs.size()) {
+                        std::ranges::copy(from.subspan(a.first, a.size), out.begin());
+                        merged[i] = a;
+                        return;
+                    }
+
+                    const auto& b = runs[(2 * i) + 1];
+                    std::ranges::merge(from.subspan(a.first, a.size), from.subspan(b.first, b.size), out.begin(), {},
+                                       &IdRange::start, &IdRange::start);
+                    merged[i] = Run{.first = a.first, .size = detail::merge(out.first(a.size + b.size))};
+                });
+            }
+        }
+        runs = std::move(merged);
+        std::swap(from, to);
+    }
+
+    assert(runs.front().first == 0);
+    if (from.data() != ranges.data()) {
+        std::ranges::copy(from.first(runs.front().size), ranges.begin());
+    }
+    ranges.resize(runs.front().size);
+}
+
+// Coalesced ranges as separate arrays of starts and ends, so a lookup only touches the starts until it has found its
+// range.
+class FreshIndex {
+public:
+    FreshIndex(std::span<const IdRange> ranges, std::pmr::memory_resource* resource)
+        : starts_{resource}, ends_{resource} {
+        auto merged = IdRanges(ranges.begin(), ranges.end(), resource);
+        coalesce(merged);
+
+        starts_.reserve(merged.size());
+        ends_.reserve(merged.size());
+        for (const auto range : merged) {
+            starts_.push_back(range.start);
+            ends_.push_back(range.end);
+        }
+    }
+
+    // Branchless binary search for the last range that starts at or before id.
+    bool contains(Id id) const {
+        if (starts_.empty()) {
+            return false;
+        }
+
+        const auto* base = starts_.data();
+        for (auto size = starts_.size(); size > 1; size -= size / 2) {
+            base = (base[size / 2] <= id) ? base + (size / 2) : base;
+        }
+        return (*base <= id) && (id <= ends_[base - starts_.data()]);
+    }
+
+    // The number of ids that are in a range. A few ids are looked up one by one. A larger batch is radix sorted and
+    // then merged with the ranges, so both are streamed through once instead of searching for every id.
+    std::size_t countFresh(std::span<const Id> ids, std::pmr::memory_resource* resource) const {
+        if (ids.size() * std::bit_width(size()) < size()) {
+            return static_cast<std::size_t>(std::ranges::count_if(ids, [this](Id id) { return contains(id); }));
+        }
+
+        auto sorted = std::pmr::vector<Id>(ids.begin(), ids.end(), resource);
+        auto scratch = std::pmr::vector<Id>(ids.size(), resource);
+        detail::radixSort(sorted, scratch);
+
+        auto result = std::size_t{0};
+        auto range = std::size_t{0};
+        for (const auto id : sorted) {
+            while ((range < size()) && (ends_[range] < id)) {
+                ++range;
+            }
+            if (range == size()) {
+                break;
+            }
+            result += (starts_[range] <= id) ? 1 : 0;
+        }
+        return result;
+    }
+
+    std::size_t size() const { return starts_.size(); }
+
+private:
+    std::pmr::vector<Id> starts_;
+    std::pmr::vector<Id> ends_;
+};
+
+// A set of ids that changes while it is in use. It holds disjoint ranges with a gap between every two of them, keyed
+// by their start, and keeps the number of ids in them up to date, so count() is constant time after every
+// logarithmic insert() or erase(). Merged and erased ranges hand their nodes back to the resource, so a set that lives
+// through many updates needs a pool resource such as std::pmr::unsynchronized_pool_resource; a monotonic arena only
+// suits a set that is built once.
+class FreshSet {
+public:
+    explicit FreshSet(std::pmr::memory_resource* resource) : ranges_{resource} {}
+
+    // From ranges that are already coalesced, in linear time.
+    FreshSet(std::span<const IdRange> coalesced, std::pmr::memory_resource* resource) : ranges_{resource} {
+        for (const auto range : coalesced) {
+            assert(ranges_.empty() || ((range.start > ranges_.rbegin()->second) &&
+                                       (range.start - ranges_.rbegin()->second > 1)));
+            ranges_.emplace_hint(ranges_.end(), range.start, range.end);
+            count_ += size(range.start, range.end);
+        }
+    }
+
+    void insert(IdRange range) {
+        assert(range.start <= range.end);
+
+        auto it = ranges_.upper_bound(range.start);
+        if (it != ranges_.begin()) {
+            const auto previous = std::prev(it);
+            if ((previous->second >= range.start) || (range.start - previous->second == 1)) {
+                it = previous;
+            }
+        }
+
+        while ((it != ranges_.end()) && ((it->first <= range.end) || (it->first - range.end == 1))) {
+            range.start = std::min(range.start, it->first);
+            range.end = std::max(range.end, it->second);
+            count_ -= size(it->first, it->second);
+            it = ranges_.erase(it);
+        }
+
+        ranges_.emplace_hint(it, range.start, range.end);
+        count_ += size(range.start, range.end);
+    }
+
+    void erase(IdRange range) {
+        assert(range.start <= range.end);
+
+        auto it = ranges_.upper_bound(range.start);
+        if ((it != ranges_.begin()) && (std::prev(it)->second >= range.start)) {
+            --it;
+        }
+
+        while ((it != ranges_.end()) && (it->first <= range.end)) {
+            const auto [start, end] = *it;
+            count_ -= size(start, end);
+            it = ranges_.erase(it);
+
+            if (start < range.start) {
+                ranges_.emplace_hint(it, start, range.start - 1);
+                count_ += size(start, range.start - 1);
+            }
+            if (end > range.end) {
+                ranges_.emplace_hint(it, range.end + 1, end);
+                count_ += size(range.end + 1, end);
+            }
+        }
+    }
+
+    // The number of ids in the set.
+    std::uint64_t count() const { return count_; }
+
+    // The number of disjoint ranges.
+    std::size_t size() const { return ranges_.size(); }
+
+private:
+    static std::uint64_t size(Id start, Id end) { return end - start + 1; }
+
+    std::pmr::map<Id, Id> ranges_;
+    std::uint64_t count_{0};
+};
+
+}  // namespace day5::fresh
@@ -1,71 +1,67 @@
+#include "day5/fresh.hpp"
+#include "shared/cache.hpp"
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
-#include <functional>
+#include <format>
+#include <memory_resource>
 #include <print>
 #include <vector>
 
-using Id = std::uint64_t;
-using Ids = std::vector<Id>;
+namespace day5::part1 {
 
-struct IdRange {
-    Id start{0};
-    Id end{0};
-};
+using fresh::FreshIndex;
+using fresh::Id;
+using fresh::IdRange;
+using fresh::IdRanges;
 
-using IdRanges = std::vector<IdRange>;
+using Ids = std::pmr::vector<Id>;
 
-bool isInRange(Id id, IdRange range) { return (id >= range.start) && (id <= range.end); }
-bool isInRanges(Id id, const IdRanges& ranges) { return std::ranges::any_of(ranges, std::bind_front(isInRange, id)); }
-
-std::tuple<std::string_view, std::string_view> splitInTwo(std::string_view str, char delim) {
-    assert(std::ranges::count(str, delim) == 1);
-
-    auto index = str.find(delim);
-    assert((index != std::string_view::npos) && (index != 0) && ((index + 1) != str.size()));
-
-    return {str.substr(0, index), str.substr(index + 1)};
+IdRange parseIdRange(std::string_view str) {
+    return parseFields<IdRange, 2>(str, '-');
 }
 
-Id parseId(std::string_view sv) {
-    assert(sv.find_first_not_of("0123456789") == std::string_view::npos);
-
-    auto id = Id{};
-    std::from_chars(sv.begin(), sv.end(), id);
-    return id;
-}
+auto parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day5.part1.parse");
+    return cache::load(path, "fresh-available", arena, [&] {
+        auto parts = yieldLines(path) | std::views::lazy_split(std::string_view{});
 
-IdRange parseIdRange(std::string_view str) {
-    return std::apply([](auto... s) { return IdRange{parseId(s)...}; }, splitInTwo(str, '-'));
-}
+        auto it = parts.begin();
+        assert(it != parts.end());
+        auto fresh = *it | std::views::transform(parseIdRange) | std::ranges::to<IdRanges>(arena.resource());
 
-auto parse(const std::filesystem::path& path) {
-    auto parts = yieldLines(path) | std::views::lazy_split(std::string_view{});
+        ++it;
+        assert(it != parts.end());
+        auto available = *it | std::views::transform(parseInt<Id>) | std::ranges::to<Ids>(arena.resource());
 
-    auto it = parts.begin();
-    assert(it != parts.end());
-    auto fresh = *it | std::views::transform(parseIdRange) | std::ranges::to<std::vector>();
+        return std::tuple{std::move(fresh), std::move(available)};
+    });
+}
 
-    ++it;
-    assert(it != parts.end());
-    auto available = *it | std::views::transform(parseId) | std::ranges::to<std::vector>();
+std::size_t solve(const IdRanges& fresh, const Ids& available) {
+    AOC_TIMER("day5.part1.solve");
+    const auto resource = fresh.get_allocator().resource();
 
-    return std::tuple{fresh, available};
+    return FreshIndex{fresh, resource}.countFresh(available, resource);
 }
 
-int solve(const IdRanges& fresh, const Ids& available) {
-    const auto isFresh = std::bind_back(isInRanges, std::cref(fresh));
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto [fresh, available] = parse(args[0], arena);
 
-    return std::ranges::count_if(available, isFresh);
+    return std::format("{}", solve(fresh, available));
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto [fresh, available] = parse(path);
+[[maybe_unused]] const auto registered = registerSolver(5, 1, run);
+
+}  // namespace day5::part1
 
-    std::println("{}", solve(fresh, available));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day5::part1::run); }
+#endif
\ No newline at end of file
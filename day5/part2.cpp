@@ -1,69 +1,58 @@
+#include "day5/fresh.hpp"
+#include "shared/cache.hpp"
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <filesystem>
+#include <format>
 #include <functional>
+#include <memory_resource>
 #include <print>
+#include <ranges>
 #include <vector>
 
-using Id = std::uint64_t;
-using Ids = std::vector<Id>;
+namespace day5::part2 {
 
-struct IdRange {
-    Id start{0};
-    Id end{0};
-};
+using fresh::FreshSet;
+using fresh::IdRange;
+using fresh::IdRanges;
 
-using IdRanges = std::vector<IdRange>;
-
-std::tuple<std::string_view, std::string_view> splitInTwo(std::string_view str, char delim) {
-    assert(std::ranges::count(str, delim) == 1);
-
-    auto index = str.find(delim);
-    assert((index != std::string_view::npos) && (index != 0) && ((index + 1) != str.size()));
-
-    return {str.substr(0, index), str.substr(index + 1)};
+IdRange parseIdRange(std::string_view str) {
+    return parseFields<IdRange, 2>(str, '-');
 }
 
-Id parseId(std::string_view sv) {
-    assert(sv.find_first_not_of("0123456789") == std::string_view::npos);
+auto parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day5.part2.parse");
+    return cache::load(path, "fresh-coalesced", arena, [&] {
+        auto result = streamLines(path) | std::views::take_while(std::not_fn(&std::string_view::empty)) |
+                      std::views::transform(parseIdRange) | std::ranges::to<IdRanges>(arena.resource());
 
-    auto id = Id{};
-    std::from_chars(sv.begin(), sv.end(), id);
-    return id;
-}
+        fresh::coalesce(result);
 
-IdRange parseIdRange(std::string_view str) {
-    return std::apply([](auto... s) { return IdRange{parseId(s)...}; }, splitInTwo(str, '-'));
+        return result;
+    });
 }
 
-auto parse(const std::filesystem::path& path) {
-    auto result = yieldLines(path) | std::views::take_while(std::not_fn(&std::string_view::empty)) |
-                  std::views::transform(parseIdRange) | std::ranges::to<std::vector>();
+std::uint64_t solve(const IdRanges& ranges) {
+    AOC_TIMER("day5.part2.solve");
+    return FreshSet{ranges, ranges.get_allocator().resource()}.count();
+}
 
-    std::ranges::sort(result, {}, &IdRange::start);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto fresh = parse(args[0], arena);
 
-    return result;
+    return std::format("{}", solve(fresh));
 }
 
-std::uint64_t solve(const IdRanges& ranges) {
-    return std::ranges::fold_left(ranges, std::pair{std::uint64_t{0}, Id{0}},
-                                  [](auto p, auto r) {
-                                      auto [count, max] = p;
-                                      if (max < r.end) {
-                                          count += r.end + 1 - std::max(r.start, max + 1);
-                                      }
-                                      return std::pair{count, std::max(max, r.end)};
-                                  })
-        .first;
-}
+[[maybe_unused]] const auto registered = registerSolver(5, 2, run);
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto fresh = parse(path);
+}  // namespace day5::part2
 
-    std::println("{}", solve(fresh));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day5::part2::run); }
+#endif
\ No newline at end of file
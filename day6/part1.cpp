@@ -1,19 +1,18 @@
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <cassert>
 #include <filesystem>
+#include <format>
 #include <functional>
+#include <memory_resource>
 #include <print>
+#include <string>
+#include <vector>
 
-using T = std::uint64_t;
+namespace day6::part1 {
 
-auto parseNr(std::string_view str) {
-    assert(!str.empty());
-    assert(str.find_first_not_of("0123456789") == std::string_view::npos);
-    auto result = T{0};
-    std::from_chars(str.begin(), str.end(), result);
-    return result;
-}
+using T = std::uint64_t;
 
 enum class Operation { add, multiply };
 
@@ -23,8 +22,10 @@ auto parseOperation(std::string_view str) {
     return (str.front() == '+') ? Operation::add : Operation::multiply;
 }
 
+using Operands = std::pmr::vector<T>;
+
 struct Problem {
-    std::vector<T> operands{};
+    Operands operands{};
     Operation operation{Operation::add};
 };
 
@@ -33,7 +34,8 @@ T solveProblem(const Problem& problem) {
                                                  : std::ranges::fold_left(problem.operands, T{1}, std::multiplies<>{});
 }
 
-auto parse(const std::filesystem::path& path) {
+auto parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day6.part1.parse");
     const auto chunker = [](char a, char b) { return (a == ' ') == (b == ' '); };
     const auto filter = [](std::string_view s) { return !s.contains(' '); };
     const auto elements = std::views::chunk_by(chunker) | as<std::string_view>() | std::views::filter(filter);
@@ -41,12 +43,14 @@ auto parse(const std::filesystem::path& path) {
     const auto lines = yieldLines(path) | as<std::string>() | std::ranges::to<std::vector>();
     assert(lines.size() >= 3);
 
-    auto problems = lines.back() | elements |
-                    std::views::transform([](auto str) { return Problem{.operation = parseOperation(str)}; }) |
-                    std::ranges::to<std::vector>();
+    auto* resource = arena.resource();
+    auto problems = lines.back() | elements | std::views::transform([resource](auto str) {
+                        return Problem{.operands = Operands(resource), .operation = parseOperation(str)};
+                    }) |
+                    std::ranges::to<std::pmr::vector<Problem>>(resource);
 
     std::ranges::for_each(lines | std::views::take(lines.size() - 1), [&](const auto& line) {
-        std::ranges::for_each(std::views::zip(problems, line | elements | std::views::transform(parseNr)),
+        std::ranges::for_each(std::views::zip(problems, line | elements | std::views::transform(parseInt<T>)),
                               [](const auto& tup) {
                                   auto& [problem, nr] = tup;
                                   problem.operands.push_back(nr);
@@ -57,13 +61,22 @@ auto parse(const std::filesystem::path& path) {
 }
 
 auto solve(const auto& problems) {
+    AOC_TIMER("day6.part1.solve");
     return std::ranges::fold_left(problems | std::views::transform(solveProblem), T{0}, std::plus<>{});
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto problems = parse(path);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto problems = parse(args[0], arena);
+
+    return std::format("{}", solve(problems));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(6, 1, run);
+
+}  // namespace day6::part1
 
-    std::println("{}", solve(problems));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day6::part1::run); }
+#endif
\ No newline at end of file
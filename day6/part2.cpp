@@ -1,32 +1,25 @@
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <format>
 #include <functional>
+#include <memory_resource>
 #include <optional>
 #include <print>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
-using T = std::uint64_t;
-
-template <typename... Ts>
-auto parseNr(const std::tuple<Ts...>& tup) {
-    auto result = T{0};
-
-    const auto parse = [&](char c) {
-        static constexpr auto table = std::string_view{"0123456789 "};
-        assert(table.contains(c));
-
-        const auto pos = table.find(c);
-        if (pos == 10) return;
-
-        result *= 10;
-        result += pos;
-    };
+namespace day6::part2 {
 
-    std::apply([&](auto... c) { (parse(c), ...); }, tup);
-
-    return result;
-}
+using T = std::uint64_t;
 
 enum class Operation { add, multiply };
 
@@ -40,79 +33,108 @@ std::optional<Operation> parseOperation(char c) {
     return std::nullopt;
 }
 
+// Column-major view of the worksheet. The rows stay in the input buffer and can have any count; cells past the end of
+// a shorter row read as spaces.
+class Columns {
+public:
+    explicit Columns(std::span<const std::string_view> rows)
+        : rows_{rows}, width_{std::ranges::max(rows | std::views::transform(&std::string_view::size))} {
+        assert(rows.size() >= 2);
+    }
+
+    std::size_t width() const { return width_; }
+
+    char at(std::size_t row, std::size_t col) const { return (col < rows_[row].size()) ? rows_[row][col] : ' '; }
+
+    bool isBlank(std::size_t col) const {
+        return std::ranges::all_of(std::views::iota(0uz, rows_.size()), [&](auto row) { return at(row, col) == ' '; });
+    }
+
+    // The number written top to bottom in the operand rows of a column.
+    T operand(std::size_t col) const {
+        auto result = T{0};
+        for (auto row = 0uz; row + 1 < rows_.size(); ++row) {
+            const auto c = at(row, col);
+            if (c == ' ') {
+                continue;
+            }
+
+            assert((c >= '0') && (c <= '9'));
+            result = (result * 10) + (c - '0');
+        }
+        return result;
+    }
+
+    std::optional<Operation> operation(std::size_t col) const { return parseOperation(at(rows_.size() - 1, col)); }
+
+private:
+    std::span<const std::string_view> rows_;
+    std::size_t width_;
+};
+
+// The operation is only known once all columns of a problem have been read, so the operands are folded both ways.
 struct Problem {
-    std::vector<T> operands{};
+    std::size_t nrOperands{0};
+    T sum{0};
+    T product{1};
     Operation operation{Operation::add};
+
+    void add(T operand) {
+        ++nrOperands;
+        sum += operand;
+        product *= operand;
+    }
 };
 
 T solveProblem(const Problem& problem) {
-    assert(!problem.operands.empty());
+    assert(problem.nrOperands > 0);
 
-    return (problem.operation == Operation::add) ? std::ranges::fold_left(problem.operands, T{0}, std::plus<>{})
-                                                 : std::ranges::fold_left(problem.operands, T{1}, std::multiplies<>{});
+    return (problem.operation == Operation::add) ? problem.sum : problem.product;
 }
 
-template <typename... Ts>
-auto allSpace(const std::tuple<Ts...>& tup) {
-    return std::apply([](auto... c) { return ((c == ' ') && ...); }, tup);
-}
-
-template <typename... Ts>
-auto allButLast(const std::tuple<Ts...>& tup) {
-    return [&tup]<std::size_t... Indices>(std::index_sequence<Indices...>) {
-        return std::tuple{std::get<Indices>(tup)...};
-    }(std::make_index_sequence<sizeof...(Ts) - 1>());
-}
-
-template <typename... Ts>
-auto last(const std::tuple<Ts...>& tup) {
-    return std::get<sizeof...(Ts) - 1>(tup);
-}
-
-auto parse(const std::filesystem::path& path) {
-    const auto lines = yieldLines(path) |
-                       std::views::transform([](auto str) { return std::string{str.rbegin(), str.rend()}; }) |
-                       std::ranges::to<std::vector>();
-    assert((lines.size() >= 4) && (lines.size() <= 5));
-
-    auto problems = std::vector<Problem>{1};
-    const auto parser = [&](const auto& tup) {
-        if (allSpace(tup)) {
-            problems.push_back(Problem{});
-            return;
+auto parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day6.part2.parse");
+    const auto input = yieldLines(path);
+    const auto rows = input | std::ranges::to<std::pmr::vector<std::string_view>>(arena.resource());
+    const auto columns = Columns{rows};
+
+    auto problems = std::pmr::vector<Problem>(arena.resource());
+    problems.emplace_back();
+    for (auto col = columns.width(); col-- > 0;) {
+        if (columns.isBlank(col)) {
+            problems.emplace_back();
+            continue;
         }
 
         auto& problem = problems.back();
+        problem.add(columns.operand(col));
 
-        problem.operands.push_back(parseNr(allButLast(tup)));
-
-        const auto operation = parseOperation(last(tup));
+        const auto operation = columns.operation(col);
         if (operation.has_value()) {
             problem.operation = operation.value();
         }
-    };
-
-    const auto impl = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
-        std::ranges::for_each(std::views::zip(lines[Indices]...), parser);
-    };
-
-    if (lines.size() == 4) {
-        impl(std::make_index_sequence<4>());
-    } else if (lines.size() == 5) {
-        impl(std::make_index_sequence<5>());
     }
 
     return problems;
 }
 
 auto solve(const auto& problems) {
+    AOC_TIMER("day6.part2.solve");
     return std::ranges::fold_left(problems | std::views::transform(solveProblem), T{0}, std::plus<>{});
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto problems = parse(path);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto problems = parse(args[0], arena);
+
+    return std::format("{}", solve(problems));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(6, 2, run);
+
+}  // namespace day6::part2
 
-    std::println("{}", solve(problems));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day6::part2::run); }
+#endif
\ No newline at end of file
@@ -1,10 +1,14 @@
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <cassert>
 #include <filesystem>
+#include <format>
 #include <print>
 #include <vector>
 
+namespace day7::part1 {
+
 enum class Element { empty, start, splitter, beam };
 
 using Row = std::vector<Element>;
@@ -72,14 +76,21 @@ State apply(const State& state, const Row& row) {
 }
 
 auto solve(const std::filesystem::path& path) {
-    auto manifold = yieldLines(path) | std::views::transform(parseRow);
+    AOC_TIMER("day7.part1.solve");
+    auto manifold = streamLines(path) | std::views::transform(parseRow);
 
     return std::ranges::fold_left(manifold, State{}, apply).nrSplits;
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    return std::format("{}", solve(args[0]));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(7, 1, run);
+
+}  // namespace day7::part1
 
-    std::println("{}", solve(path));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day7::part1::run); }
+#endif
\ No newline at end of file
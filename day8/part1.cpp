@@ -1,18 +1,24 @@
+#include "shared/cache.hpp"
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <cassert>
 #include <cmath>
 #include <filesystem>
+#include <format>
+#include <memory_resource>
 #include <print>
 #include <vector>
 
+namespace day8::part1 {
+
 struct Box {
     std::uint64_t x{0};
     std::uint64_t y{0};
     std::uint64_t z{0};
 };
 
-using Boxes = std::vector<Box>;
+using Boxes = std::pmr::vector<Box>;
 
 auto distance(Box a, Box b) {
     static constexpr auto d = [](auto a, auto b) { return static_cast<double>(a) - static_cast<double>(b); };
@@ -20,44 +26,32 @@ auto distance(Box a, Box b) {
     return std::hypot(d(a.x, b.x), d(a.y, b.y), d(a.z, b.z));
 }
 
-template <typename T, std::size_t N, typename R>
-T makeFromRange(R&& range) {
-    static constexpr auto element = [](R& range, auto& it, std::size_t) {
-        assert(it != range.end());
-        return *(it++);
-    };
-    static constexpr auto impl = []<std::size_t... Indices>(R& range, std::index_sequence<Indices...>) {
-        auto it = range.begin();
-        auto result = T{element(range, it, Indices)...};
-        assert(it == range.end());
-        return result;
-    };
-
-    return impl(range, std::make_index_sequence<N>());
-}
-
 Box parseBox(std::string_view str) {
-    return makeFromRange<Box, 3>(str | std::views::split(',') | as<std::string_view>() |
-                                 std::views::transform(parseInt<std::uint64_t>));
+    return parseFields<Box, 3>(str, ',');
 }
 
-Boxes parse(const std::filesystem::path& path) {
-    return yieldLines(path) | std::views::transform(parseBox) | std::ranges::to<std::vector>();
+Boxes parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day8.part1.parse");
+    return cache::load(path, "boxes", arena, [&] { return parseLinesParallel(path, arena, parseBox); });
 }
 
-using Indices = std::vector<std::size_t>;
+using Indices = std::pmr::vector<std::size_t>;
+using Pairs = std::pmr::vector<std::pair<std::size_t, std::size_t>>;
 
-auto solve(const Boxes& boxes, std::size_t nrConnections) {
+auto solve(const Boxes& boxes, std::size_t nrConnections, std::pmr::memory_resource* resource) {
+    AOC_TIMER("day8.part1.solve");
     const auto size = boxes.size();
-    auto boxToCircuit = std::views::iota(0uz, size) | std::ranges::to<Indices>();
-    auto circuits = std::views::iota(0uz, size) | std::views::transform([](auto i) { return Indices{{i}}; }) |
-                    std::ranges::to<std::vector>();
+    auto boxToCircuit = std::views::iota(0uz, size) | std::ranges::to<Indices>(resource);
+    auto circuits = std::views::iota(0uz, size) |
+                    std::views::transform([resource](auto i) { return Indices({i}, resource); }) |
+                    std::ranges::to<std::pmr::vector<Indices>>(resource);
 
     auto combinations =
         std::views::iota(0uz, size) | std::views::transform([size](auto i) {
             return std::views::iota(i + 1, size) | std::views::transform([i](auto j) { return std::pair{i, j}; });
         }) |
-        std::views::join | std::ranges::to<std::vector>();
+        std::views::join | std::ranges::to<Pairs>(resource);
+    AOC_COUNT("day8.part1.pairs", combinations.size());
     assert(nrConnections < combinations.size());
     std::ranges::partial_sort(combinations, std::next(combinations.begin(), nrConnections), {}, [&](auto t) {
         const auto [i1, i2] = t;
@@ -91,11 +85,19 @@ auto solve(const Boxes& boxes, std::size_t nrConnections) {
                                   std::multiplies<>{});
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 3);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto nrConnections = parseInt<int>(argv[2]);
-    auto problem = parse(path);
+std::string run(Args args) {
+    assert(args.size() >= 2);
+    const auto nrConnections = parseInt<int>(args[1]);
+    auto arena = Arena{};
+    auto problem = parse(args[0], arena);
+
+    return std::format("{}", solve(problem, nrConnections, arena.resource()));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(8, 1, run);
+
+}  // namespace day8::part1
 
-    std::println("{}", solve(problem, nrConnections));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day8::part1::run); }
+#endif
\ No newline at end of file
@@ -1,11 +1,17 @@
+#include "shared/cache.hpp"
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <cassert>
 #include <cmath>
 #include <filesystem>
+#include <format>
+#include <memory_resource>
 #include <print>
 #include <vector>
 
+namespace day9::part1 {
+
 struct Location {
     std::uint64_t x{0};
     std::uint64_t y{0};
@@ -16,24 +22,26 @@ std::uint64_t area(Location a, Location b) {
     return dist(a.x, b.x) * dist(a.y, b.y);
 }
 
-using Locations = std::vector<Location>;
+using Locations = std::pmr::vector<Location>;
 
 Location parseLocation(std::string_view str) {
-    return makeFromRange<Location, 2>(str | std::views::split(',') | as<std::string_view>() |
-                                      std::views::transform(parseInt<std::uint64_t>));
+    return parseFields<Location, 2>(str, ',');
 }
 
-Locations parse(const std::filesystem::path& path) {
-    return yieldLines(path) | std::views::transform(parseLocation) | std::ranges::to<std::vector>();
+Locations parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day9.part1.parse");
+    return cache::load(path, "locations-xy", arena, [&] { return parseLinesParallel(path, arena, parseLocation); });
 }
 
 auto solve(const Locations& locations) {
+    AOC_TIMER("day9.part1.solve");
     const auto size = locations.size();
     auto combinations =
         std::views::iota(0uz, size) | std::views::transform([size](auto i) {
             return std::views::iota(i + 1, size) | std::views::transform([i](auto j) { return std::pair{i, j}; });
         }) |
         std::views::join;
+    AOC_COUNT("day9.part1.rectangles", size * (size - 1) / 2);
 
     return std::ranges::max(combinations | std::views::transform([&locations](auto p) {
                                 const auto [indexA, indexB] = p;
@@ -43,10 +51,18 @@ auto solve(const Locations& locations) {
                             }));
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto problem = parse(path);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto problem = parse(args[0], arena);
+
+    return std::format("{}", solve(problem));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(9, 1, run);
+
+}  // namespace day9::part1
 
-    std::println("{}", solve(problem));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day9::part1::run); }
+#endif
\ No newline at end of file
@@ -1,12 +1,20 @@
+#include "shared/cache.hpp"
 #include "shared/shared.hpp"
+#include "shared/solver.hpp"
 
 #include <cassert>
 #include <cmath>
 #include <filesystem>
+#include <format>
+#include <generator>
+#include <memory_resource>
 #include <print>
+#include <utility>
 #include <variant>
 #include <vector>
 
+namespace day9::part2 {
+
 struct Row {
     std::uint64_t r{0};
 
@@ -34,15 +42,15 @@ std::uint64_t area(Rectangle r) {
     return dist(r.a.row.r, r.b.row.r) * dist(r.a.col.c, r.b.col.c);
 }
 
-using Locations = std::vector<Location>;
+using Locations = std::pmr::vector<Location>;
 
 Location parseLocation(std::string_view str) {
-    return makeFromRange<Location, 2>(str | std::views::split(',') | as<std::string_view>() |
-                                      std::views::transform(parseInt<std::uint64_t>));
+    return parseFields<Location, 2>(str, ',');
 }
 
-Locations parse(const std::filesystem::path& path) {
-    return yieldLines(path) | std::views::transform(parseLocation) | std::ranges::to<std::vector>();
+Locations parse(const std::filesystem::path& path, Arena& arena) {
+    AOC_TIMER("day9.part2.parse");
+    return cache::load(path, "locations-colrow", arena, [&] { return parseLinesParallel(path, arena, parseLocation); });
 }
 
 template <typename T, typename R>
@@ -69,6 +77,8 @@ std::generator<T> yieldMerged(R& r1, R& r2) {
 
 class Floor {
 public:
+    explicit Floor(std::pmr::memory_resource* resource) : data_{resource} {}
+
     void addLine(Location a, Location b) {
         assert((a.row == b.row) || (a.col == b.col));
 
@@ -88,10 +98,11 @@ public:
     void normalize() {
         std::ranges::for_each(data_, std::ranges::sort);
 
-        auto curState = std::vector<ColRange>{};
-        std::ranges::for_each(data_, [&curState](auto& curRow) {
-            auto nextRow = std::vector<ColRange>{};
-            auto nextState = std::vector<ColRange>{};
+        const auto allocator = data_.get_allocator();
+        auto curState = ColRanges(allocator);
+        std::ranges::for_each(data_, [&curState, &allocator](auto& curRow) {
+            auto nextRow = ColRanges(allocator);
+            auto nextState = ColRanges(allocator);
 
             for (auto toProcess : yieldMerged<ColRange>(curState, curRow)) {
                 [&nextRow](auto b) {
@@ -180,8 +191,8 @@ public:
                 }(toProcess);
             }
 
-            curState = nextState;
-            curRow = nextRow;
+            curState = std::move(nextState);
+            curRow = std::move(nextRow);
         });
     }
 
@@ -204,16 +215,19 @@ private:
         constexpr auto operator<=>(const ColRange&) const noexcept = default;
     };
 
-    std::vector<std::vector<ColRange>> data_;
+    using ColRanges = std::pmr::vector<ColRange>;
+
+    std::pmr::vector<ColRanges> data_;
 };
 
-Floor makeFloor(const Locations& locations) {
+Floor makeFloor(const Locations& locations, std::pmr::memory_resource* resource) {
+    AOC_TIMER("day9.part2.build");
     assert(!std::ranges::contains(locations | std::views::adjacent_transform<3>([](auto a, auto b, auto c) {
                                       return ((a.row == b.row) && (b.row == c.row)) ||
                                              ((a.col == b.col) && (b.col == c.col));
                                   }),
                                   true));
-    auto floor = Floor{};
+    auto floor = Floor{resource};
 
     assert(locations.size() >= 2);
 
@@ -228,8 +242,9 @@ Floor makeFloor(const Locations& locations) {
     return floor;
 }
 
-auto solve(const Locations& locations) {
-    const auto floor = makeFloor(locations);
+auto solve(const Locations& locations, std::pmr::memory_resource* resource) {
+    AOC_TIMER("day9.part2.solve");
+    const auto floor = makeFloor(locations, resource);
 
     const auto size = locations.size();
     auto rectangles = std::views::iota(0uz, size) | std::views::transform([&locations, size](auto i) {
@@ -239,14 +254,25 @@ auto solve(const Locations& locations) {
                       }) |
                       std::views::join;
 
-    return std::ranges::max(rectangles | std::views::filter([&floor](auto r) { return floor.isTiled(r); }) |
+    return std::ranges::max(rectangles | std::views::filter([&floor](auto r) {
+                                AOC_COUNT("day9.part2.isTiled", 1);
+                                return floor.isTiled(r);
+                            }) |
                             std::views::transform(area));
 }
 
-int main(int argc, const char** argv) {
-    assert(argc >= 2);
-    const auto path = std::filesystem::path{argv[1]};
-    const auto problem = parse(path);
+std::string run(Args args) {
+    assert(args.size() >= 1);
+    auto arena = Arena{};
+    const auto problem = parse(args[0], arena);
+
+    return std::format("{}", solve(problem, arena.resource()));
+}
+
+[[maybe_unused]] const auto registered = registerSolver(9, 2, run);
+
+}  // namespace day9::part2
 
-    std::println("{}", solve(problem));
-}
\ No newline at end of file
+#ifndef AOC_NO_MAIN
+int main(int argc, const char** argv) { return runMain(argc, argv, day9::part2::run); }
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "shared/shared.hpp"
+#include "shared/solver.hpp"
+#include "shared/thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One job per manifest line: "<day> <part> <input> [extra args...]". Empty lines and lines starting with '#' are
+// skipped.
+struct Job {
+    int day{0};
+    int part{0};
+    std::vector<std::string> args;
+};
+
+Job parseJob(std::string_view str) {
+    auto words = str | std::views::split(' ') | as<std::string_view>() |
+                 std::views::filter(std::not_fn(&std::string_view::empty)) | std::ranges::to<std::vector>();
+    assert(words.size() >= 3);
+
+    return Job{.day = parseInt<int>(words[0]),
+               .part = parseInt<int>(words[1]),
+               .args = words | std::views::drop(2) | as<std::string>() | std::ranges::to<std::vector>()};
+}
+
+std::vector<Job> parse(const std::filesystem::path& path) {
+    return yieldLines(path) | std::views::filter([](auto line) { return !line.empty() && !line.starts_with('#'); }) |
+           std::views::transform(parseJob) | std::ranges::to<std::vector>();
+}
+
+Solver findSolver(int day, int part) {
+    const auto it = std::ranges::find_if(solvers(), [=](const auto& info) {
+        return (info.day == day) && (info.part == part);
+    });
+    return (it == solvers().end()) ? nullptr : it->solver;
+}
+
+std::string runJob(const Job& job) {
+    const auto solver = findSolver(job.day, job.part);
+    if (solver == nullptr) {
+        return "unknown solver";
+    }
+
+    const auto args = job.args | std::views::transform([](const auto& arg) { return arg.c_str(); }) |
+                      std::ranges::to<std::vector>();
+    return solver(args);
+}
+
+int main(int argc, const char** argv) {
+    if (argc < 2) {
+        std::println(stderr, "usage: {} <manifest>", argv[0]);
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto jobs = parse(argv[1]);
+    auto results = std::vector<std::string>(jobs.size());
+    {
+        auto group = TaskGroup{};
+        for (auto i = 0uz; i < jobs.size(); ++i) {
+            group.run([&jobs, &results, i] { results[i] = runJob(jobs[i]); });
+        }
+    }
+
+    for (const auto& [job, result] : std::views::zip(jobs, results)) {
+        std::println("day{}.part{} {}: {}", job.day, job.part, job.args.front(), result);
+    }
+
+    const auto elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+    std::println(stderr, "{} jobs in {:.3f} s", jobs.size(), elapsed.count());
+    instrument::report();
+}
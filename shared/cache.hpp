@@ -0,0 +1,373 @@
+#pragma once
+
+#include "shared/instrument.hpp"
+#include "shared/shared.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+// Opt-in binary image of parsed input. When the AOC_CACHE environment variable is set, cache::load() stores the
+// result of the parser in "<input>.<tag>.cache" and later runs read that image instead of parsing the text again.
+// The image is only used when the size and modification time of the input and the layout of the type still match, and
+// an image that turns out to be malformed is parsed again. Stdin is never cached.
+//
+// Supported types are trivially copyable types, vectors of supported types, tuples of supported types and aggregates
+// with a members() function that returns std::tie() of all their fields in declaration order. Pointers and string
+// views point into memory of the run that wrote them and cannot be cached.
+
+namespace cache {
+
+namespace detail {
+
+inline constexpr auto magic = std::uint64_t{0x4548434143434f41};  // "AOCCACHE"
+inline constexpr auto version = std::uint64_t{2};
+
+struct Header {
+    std::uint64_t magic{0};
+    std::uint64_t version{0};
+    std::uint64_t fingerprint{0};
+    std::uint64_t sourceSize{0};
+    std::int64_t sourceTime{0};
+    std::uint64_t payloadSize{0};
+};
+
+template <typename T>
+struct IsVector : std::false_type {};
+
+template <typename T, typename A>
+struct IsVector<std::vector<T, A>> : std::true_type {};
+
+template <typename T>
+struct IsTuple : std::false_type {};
+
+template <typename... Ts>
+struct IsTuple<std::tuple<Ts...>> : std::true_type {};
+
+template <typename T>
+concept HasMembers = requires(const T& t) { t.members(); };
+
+template <typename T>
+using Members = decltype(std::declval<const T&>().members());
+
+template <typename T>
+struct IsStringView : std::false_type {};
+
+template <typename C, typename Traits>
+struct IsStringView<std::basic_string_view<C, Traits>> : std::true_type {};
+
+// Converts to any field type, to count the fields of an aggregate. Only used in unevaluated contexts.
+struct AnyField {
+    template <typename T>
+    operator T() const;
+};
+
+template <typename T, typename... Fields>
+consteval std::size_t fieldCount() {
+    if constexpr (requires { T{Fields{}..., AnyField{}}; }) {
+        return fieldCount<T, Fields..., AnyField>();
+    } else {
+        return sizeof...(Fields);
+    }
+}
+
+inline constexpr auto maxFields = std::size_t{4};
+
+// The fields of a type as std::tie() returns them: from members(), or else from a structured binding. Only used for
+// its type.
+template <typename T>
+auto tieFields(const T& t) {
+    static constexpr auto count = HasMembers<T> ? 0 : fieldCount<T>();
+    static_assert(count <= maxFields, "give the type a members() function");
+
+    if constexpr (HasMembers<T>) {
+        return t.members();
+    } else if constexpr (count == 1) {
+        const auto& [a] = t;
+        return std::tie(a);
+    } else if constexpr (count == 2) {
+        const auto& [a, b] = t;
+        return std::tie(a, b);
+    } else if constexpr (count == 3) {
+        const auto& [a, b, c] = t;
+        return std::tie(a, b, c);
+    } else if constexpr (count == 4) {
+        const auto& [a, b, c, d] = t;
+        return std::tie(a, b, c, d);
+    } else {
+        return std::tie();
+    }
+}
+
+template <typename T>
+using Fields = decltype(tieFields(std::declval<const T&>()));
+
+enum class Kind : std::uint64_t { integral, floating, enumeration, opaque, vector, tuple, aggregate };
+
+consteval std::uint64_t mix(std::uint64_t hash, std::uint64_t value) {
+    hash = (hash ^ value) * 0x100000001b3;  // FNV-1a prime
+    return hash ^ (hash >> 32);
+}
+
+template <typename T>
+consteval std::uint64_t fingerprint();
+
+template <typename Tuple, std::size_t... Indices>
+consteval std::uint64_t fingerprintFields(Kind kind, std::index_sequence<Indices...>) {
+    auto hash = mix(mix(0xcbf29ce484222325, static_cast<std::uint64_t>(kind)), sizeof...(Indices));
+    ((hash = mix(hash, fingerprint<std::remove_cvref_t<std::tuple_element_t<Indices, Tuple>>>())), ...);
+    return hash;
+}
+
+// Describes how a type is stored: the kind, size and signedness of every value, and recursively the fields and
+// elements of compound values. An image is only read back as the type it was written as.
+template <typename T>
+consteval std::uint64_t fingerprint() {
+    static_assert(!std::is_pointer_v<T> && !std::is_member_pointer_v<T> && !IsStringView<T>::value,
+                  "type refers to memory outside the image and cannot be cached");
+
+    if constexpr (IsVector<T>::value) {
+        return mix(static_cast<std::uint64_t>(Kind::vector), fingerprint<typename T::value_type>());
+    } else if constexpr (IsTuple<T>::value) {
+        return fingerprintFields<T>(Kind::tuple, std::make_index_sequence<std::tuple_size_v<T>>());
+    } else if constexpr (HasMembers<T> || (std::is_class_v<T> && std::is_aggregate_v<T>)) {
+        return mix(fingerprintFields<Fields<T>>(Kind::aggregate,
+                                                std::make_index_sequence<std::tuple_size_v<Fields<T>>>()),
+                   sizeof(T));
+    } else {
+        constexpr auto kind = std::is_integral_v<T>         ? Kind::integral
+                              : std::is_floating_point_v<T> ? Kind::floating
+                              : std::is_enum_v<T>           ? Kind::enumeration
+                                                            : Kind::opaque;
+        return mix(mix(static_cast<std::uint64_t>(kind), sizeof(T)), std::is_signed_v<T>);
+    }
+}
+
+class Writer {
+public:
+    template <typename T>
+    void write(const T& value) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            append(&value, sizeof(T));
+        } else if constexpr (IsVector<T>::value) {
+            write(static_cast<std::uint64_t>(value.size()));
+            if constexpr (std::is_trivially_copyable_v<typename T::value_type>) {
+                append(value.data(), value.size() * sizeof(typename T::value_type));
+            } else {
+                std::ranges::for_each(value, [this](const auto& e) { write(e); });
+            }
+        } else if constexpr (IsTuple<T>::value) {
+            std::apply([this](const auto&... e) { (write(e), ...); }, value);
+        } else {
+            static_assert(HasMembers<T>, "type cannot be cached");
+            std::apply([this](const auto&... e) { (write(e), ...); }, value.members());
+        }
+    }
+
+    const std::string& data() const { return data_; }
+
+private:
+    void append(const void* data, std::size_t size) { data_.append(static_cast<const char*>(data), size); }
+
+    std::string data_;
+};
+
+class Reader {
+public:
+    Reader(std::string_view data, std::pmr::memory_resource* resource) : data_{data}, resource_{resource} {}
+
+    // Values are built by construction rather than assignment so that every pmr container gets the arena's resource.
+    template <typename T>
+    T read() {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            auto result = T{};
+            take(&result, sizeof(T));
+            return result;
+        } else if constexpr (IsVector<T>::value) {
+            using E = typename T::value_type;
+
+            const auto size = read<std::uint64_t>();
+            auto result = makeVector<T>();
+            if constexpr (std::is_trivially_copyable_v<E>) {
+                if (size > data_.size() / sizeof(E)) {
+                    failed_ = true;
+                    return result;
+                }
+                result.resize(size);
+                take(result.data(), size * sizeof(E));
+            } else {
+                // Every element takes at least one byte.
+                if (size > data_.size()) {
+                    failed_ = true;
+                    return result;
+                }
+                result.reserve(size);
+                for (auto i = std::uint64_t{0}; (i < size) && !failed_; ++i) {
+                    result.push_back(read<E>());
+                }
+            }
+            return result;
+        } else if constexpr (IsTuple<T>::value) {
+            return readFields<T, T>(std::make_index_sequence<std::tuple_size_v<T>>());
+        } else {
+            static_assert(HasMembers<T>, "type cannot be cached");
+            return readFields<T, Members<T>>(std::make_index_sequence<std::tuple_size_v<Members<T>>>());
+        }
+    }
+
+    // Whether the whole image was read without running past its end.
+    bool done() const { return !failed_ && data_.empty(); }
+
+private:
+    template <typename T>
+    T makeVector() {
+        if constexpr (std::same_as<typename T::allocator_type,
+                                   std::pmr::polymorphic_allocator<typename T::value_type>>) {
+            return T(resource_);
+        } else {
+            return T{};
+        }
+    }
+
+    // Braced initialization evaluates its elements from left to right, which is the order they were written in.
+    template <typename T, typename Fields, std::size_t... Indices>
+    T readFields(std::index_sequence<Indices...>) {
+        return T{read<std::remove_cvref_t<std::tuple_element_t<Indices, Fields>>>()...};
+    }
+
+    void take(void* data, std::size_t size) {
+        if (size > data_.size()) {
+            failed_ = true;
+            data_ = {};
+            return;
+        }
+        if (size > 0) {
+            std::memcpy(data, data_.data(), size);
+        }
+        data_.remove_prefix(size);
+    }
+
+    std::string_view data_;
+    std::pmr::memory_resource* resource_;
+    bool failed_{false};
+};
+
+inline std::optional<Header> makeHeader(const std::filesystem::path& source, std::uint64_t fingerprint) {
+    auto error = std::error_code{};
+    const auto size = std::filesystem::file_size(source, error);
+    if (error) {
+        return std::nullopt;
+    }
+    const auto time = std::filesystem::last_write_time(source, error);
+    if (error) {
+        return std::nullopt;
+    }
+
+    return Header{.magic = magic,
+                  .version = version,
+                  .fingerprint = fingerprint,
+                  .sourceSize = size,
+                  .sourceTime = static_cast<std::int64_t>(time.time_since_epoch().count())};
+}
+
+inline bool matches(const Header& a, const Header& b) {
+    return (a.magic == b.magic) && (a.version == b.version) && (a.fingerprint == b.fingerprint) &&
+           (a.sourceSize == b.sourceSize) && (a.sourceTime == b.sourceTime);
+}
+
+// Writes to a private temporary file first, so concurrent runs never see a partial image.
+inline void store(const std::filesystem::path& path, Header header, const std::string& payload) {
+    header.payloadSize = payload.size();
+
+    const auto temporary = std::filesystem::path{
+        std::format("{}.{}.{}", path.string(), ::getpid(), std::hash<std::thread::id>{}(std::this_thread::get_id()))};
+    auto written = false;
+    {
+        auto output = std::ofstream{temporary, std::ios::binary};
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        written = static_cast<bool>(output.flush());
+    }
+
+    auto error = std::error_code{};
+    if (written) {
+        std::filesystem::rename(temporary, path, error);
+    }
+    if (!written || error) {
+        std::filesystem::remove(temporary, error);
+    }
+}
+
+}  // namespace detail
+
+inline bool enabled() { return std::getenv("AOC_CACHE") != nullptr; }
+
+// Returns parser(), or the image of an earlier parser() for the same input and tag. Containers are allocated from
+// the arena. Solvers that parse into different types should use different tags, or they keep replacing each other's
+// image.
+template <typename F>
+auto load(const std::filesystem::path& source, std::string_view tag, Arena& arena, F parser) {
+    using T = decltype(parser());
+
+    if (!enabled() || isStdin(source)) {
+        return parser();
+    }
+
+    static constexpr auto fingerprint = detail::fingerprint<T>();
+
+    const auto header = detail::makeHeader(source, fingerprint);
+    if (!header.has_value()) {
+        return parser();
+    }
+
+    const auto path = std::filesystem::path{std::format("{}.{}.cache", source.string(), tag)};
+    {
+        const auto file = MappedFile{path};
+        auto data = file.view();
+
+        auto stored = detail::Header{};
+        if (data.size() >= sizeof(stored)) {
+            std::memcpy(&stored, data.data(), sizeof(stored));
+            data.remove_prefix(sizeof(stored));
+        }
+
+        if (detail::matches(stored, *header) && (stored.payloadSize == data.size())) {
+            auto reader = detail::Reader{data, arena.resource()};
+            auto result = reader.read<T>();
+            if (reader.done()) {
+                AOC_COUNT("cache.hits", 1);
+                return result;
+            }
+        }
+    }
+
+    AOC_COUNT("cache.misses", 1);
+    auto result = parser();
+
+    auto writer = detail::Writer{};
+    writer.write(result);
+    detail::store(path, *header, writer.data());
+
+    return result;
+}
+
+}  // namespace cache
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Phase timers and counters. They only do something when compiled with -DAOC_INSTRUMENT; otherwise the macros
+// expand to nothing and their arguments are not evaluated.
+//
+//   AOC_TIMER("day8.part1.parse");          // times the enclosing scope
+//   AOC_COUNT("day8.part1.pairs", n);       // adds n to a named counter
+//
+// instrument::report() prints the collected metrics to stderr, or writes them as JSON to the file named by the
+// AOC_INSTRUMENT_JSON environment variable.
+//
+// Traces are compiled in separately with -DAOC_TRACE:
+//
+//   AOC_TRACE_LOG(trace, "day1.part2", int, int);  // declares a log with two int columns
+//   AOC_TRACE_ROW(trace, a, b);                    // appends one row
+//
+// A log is written to "<name>.trace" in the directory named by AOC_TRACE_DIR (default: the working directory).
+
+#define AOC_CONCAT_IMPL(a, b) a##b
+#define AOC_CONCAT(a, b) AOC_CONCAT_IMPL(a, b)
+
+#ifdef AOC_INSTRUMENT
+#define AOC_TIMER(name)                                                           \
+    static auto& AOC_CONCAT(aocTimerMetric, __LINE__) = instrument::metric(name); \
+    const auto AOC_CONCAT(aocTimer, __LINE__) = instrument::ScopedTimer{AOC_CONCAT(aocTimerMetric, __LINE__)}
+#define AOC_COUNT(name, n)                                              \
+    do {                                                                \
+        static auto& aocCountMetric = instrument::metric(name);         \
+        aocCountMetric.count.fetch_add((n), std::memory_order_relaxed); \
+    } while (false)
+#else
+#define AOC_TIMER(name) static_cast<void>(0)
+#define AOC_COUNT(name, n) static_cast<void>(0)
+#endif
+
+#ifdef AOC_TRACE
+#define AOC_TRACE_LOG(var, name, ...) auto var = instrument::TraceLog<__VA_ARGS__>{name}
+#define AOC_TRACE_ROW(var, ...) var.append(__VA_ARGS__)
+#else
+#define AOC_TRACE_LOG(var, name, ...) static_cast<void>(0)
+#define AOC_TRACE_ROW(var, ...) static_cast<void>(0)
+#endif
+
+namespace instrument {
+
+using Clock = std::chrono::steady_clock;
+
+struct Metric {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> nanoseconds{0};
+    std::atomic<std::uint64_t> count{0};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, Metric, std::less<>> metrics;
+};
+
+inline Registry& registry() {
+    static auto result = Registry{};
+    return result;
+}
+
+inline Metric& metric(std::string_view name) {
+    auto& r = registry();
+    const auto lock = std::scoped_lock{r.mutex};
+    return r.metrics.try_emplace(std::string{name}).first->second;
+}
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Metric& metric) : metric_{metric} {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_);
+        metric_.calls.fetch_add(1, std::memory_order_relaxed);
+        metric_.nanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    }
+
+private:
+    Metric& metric_;
+    Clock::time_point start_{Clock::now()};
+};
+
+inline void report() {
+    auto& r = registry();
+    const auto lock = std::scoped_lock{r.mutex};
+    if (r.metrics.empty()) {
+        return;
+    }
+
+    const auto seconds = [](const Metric& m) { return static_cast<double>(m.nanoseconds.load()) * 1e-9; };
+
+    if (const auto* path = std::getenv("AOC_INSTRUMENT_JSON"); path != nullptr) {
+        auto output = std::ofstream{path};
+        std::println(output, "{{");
+        for (auto separator = ""; const auto& [name, m] : r.metrics) {
+            std::print(output, "{}\n  \"{}\": {{\"calls\": {}, \"seconds\": {:.9f}, \"count\": {}}}", separator,
+                       name, m.calls.load(), seconds(m), m.count.load());
+            separator = ",";
+        }
+        std::println(output, "\n}}");
+        return;
+    }
+
+    std::println(stderr, "{:<40} {:>10} {:>14} {:>16}", "metric", "calls", "time [ms]", "count");
+    for (const auto& [name, m] : r.metrics) {
+        std::println(stderr, "{:<40} {:>10} {:>14.3f} {:>16}", name, m.calls.load(), seconds(m) * 1e3,
+                     m.count.load());
+    }
+}
+
+// Binary, columnar trace. The file starts with the magic "AOCTRACE", the number of columns and the size of each
+// column's elements, all as 64-bit integers. Blocks follow: the number of rows, then the values of every column in
+// turn. Rows are buffered and written one block at a time.
+template <typename... Columns>
+class TraceLog {
+public:
+    static_assert((std::is_trivially_copyable_v<Columns> && ...));
+
+    explicit TraceLog(std::string_view name) {
+        const auto* dir = std::getenv("AOC_TRACE_DIR");
+        output_.open(std::filesystem::path{(dir == nullptr) ? "." : dir} / std::format("{}.trace", name),
+                     std::ios::binary);
+
+        writeValue(std::uint64_t{0x4543415254434f41});  // "AOCTRACE"
+        writeValue(std::uint64_t{sizeof...(Columns)});
+        (writeValue(std::uint64_t{sizeof(Columns)}), ...);
+    }
+
+    TraceLog(const TraceLog&) = delete;
+    TraceLog& operator=(const TraceLog&) = delete;
+
+    ~TraceLog() { flush(); }
+
+    void append(Columns... values) {
+        std::apply([&](auto&... columns) { (columns.push_back(values), ...); }, columns_);
+        if (std::get<0>(columns_).size() == blockSize) {
+            flush();
+        }
+    }
+
+    void flush() {
+        const auto size = std::get<0>(columns_).size();
+        if (size == 0) {
+            return;
+        }
+
+        writeValue(std::uint64_t{size});
+        std::apply(
+            [&](auto&... columns) {
+                ((output_.write(reinterpret_cast<const char*>(columns.data()),
+                                static_cast<std::streamsize>(columns.size() * sizeof(columns[0]))),
+                  columns.clear()),
+                 ...);
+            },
+            columns_);
+    }
+
+private:
+    static constexpr auto blockSize = std::size_t{1} << 16;
+
+    template <typename T>
+    void writeValue(T value) {
+        output_.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    std::ofstream output_;
+    std::tuple<std::vector<Columns>...> columns_;
+};
+
+}  // namespace instrument
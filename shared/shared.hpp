@@ -1,21 +1,445 @@
 #pragma once
 
+#include "shared/instrument.hpp"
+#include "shared/thread_pool.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
-#include <generator>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path& path) {
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        *this = MappedFile{fd};
+        ::close(fd);
+    }
+
+    // Maps the file that fd refers to. The descriptor stays open.
+    explicit MappedFile(int fd) {
+        struct stat info {};
+        if ((::fstat(fd, &info) == 0) && (info.st_size > 0)) {
+            const auto size = static_cast<std::size_t>(info.st_size);
+            auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+            if (data != MAP_FAILED) {
+                ::madvise(data, size, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(data);
+                size_ = size;
+            }
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    const char* data_{nullptr};
+    std::size_t size_{0};
+};
+
+class LineIterator {
+public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    LineIterator() = default;
+    LineIterator(const char* begin, const char* end) : begin_{begin}, eol_{findEol(begin, end)}, end_{end} {}
+
+    std::string_view operator*() const {
+        auto size = static_cast<std::size_t>(eol_ - begin_);
+        if ((size > 0) && (begin_[size - 1] == '\r')) {
+            --size;
+        }
+        return {begin_, size};
+    }
+
+    LineIterator& operator++() {
+        begin_ = (eol_ == end_) ? end_ : std::next(eol_);
+        eol_ = findEol(begin_, end_);
+        return *this;
+    }
+
+    LineIterator operator++(int) {
+        const auto prev = *this;
+        operator++();
+        return prev;
+    }
+
+    bool operator==(const LineIterator& rhs) const { return begin_ == rhs.begin_; }
+
+private:
+    static const char* findEol(const char* begin, const char* end) {
+        if (begin == end) {
+            return end;
+        }
+        const auto* eol = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        return (eol == nullptr) ? end : eol;
+    }
+
+    const char* begin_{nullptr};
+    const char* eol_{nullptr};
+    const char* end_{nullptr};
+};
+
+// "-" names stdin wherever an input path is expected.
+inline bool isStdin(const std::filesystem::path& path) { return path == "-"; }
+
+// Descriptor of an input: stdin for "-", otherwise the opened path. Only regular files can be mapped; pipes, FIFOs,
+// /dev/stdin and process substitutions report a size of 0 and have to be read.
+class InputDescriptor {
+public:
+    explicit InputDescriptor(const std::filesystem::path& path)
+        : fd_{isStdin(path) ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY)}, owned_{!isStdin(path)} {}
+
+    InputDescriptor(const InputDescriptor&) = delete;
+    InputDescriptor& operator=(const InputDescriptor&) = delete;
+
+    InputDescriptor(InputDescriptor&& other) noexcept
+        : fd_{std::exchange(other.fd_, -1)}, owned_{std::exchange(other.owned_, false)} {}
+
+    InputDescriptor& operator=(InputDescriptor&& other) noexcept {
+        std::swap(fd_, other.fd_);
+        std::swap(owned_, other.owned_);
+        return *this;
+    }
+
+    ~InputDescriptor() {
+        if (owned_ && (fd_ >= 0)) {
+            ::close(fd_);
+        }
+    }
+
+    int get() const { return fd_; }
+
+    bool isRegular() const {
+        struct stat info {};
+        return (fd_ >= 0) && (::fstat(fd_, &info) == 0) && S_ISREG(info.st_mode);
+    }
+
+private:
+    int fd_{-1};
+    bool owned_{false};
+};
+
+// ::read() that is restarted when a signal interrupts it.
+inline ssize_t readSome(int fd, char* data, std::size_t size) {
+    while (true) {
+        const auto count = ::read(fd, data, size);
+        if ((count >= 0) || (errno != EINTR)) {
+            return count;
+        }
+    }
+}
+
+inline std::string readAll(int fd) {
+    static constexpr auto blockSize = std::size_t{1} << 16;
+
+    auto result = std::string{};
+    while (true) {
+        const auto size = result.size();
+        result.resize(size + blockSize);
+        const auto count = readSome(fd, result.data() + size, blockSize);
+        result.resize(size + static_cast<std::size_t>(std::max<ssize_t>(count, 0)));
+        if (count <= 0) {
+            return result;
+        }
+    }
+}
+
+// The complete contents of an input: regular files are mapped, anything else is read into memory.
+class InputFile {
+public:
+    InputFile() = default;
+    explicit InputFile(const std::filesystem::path& path) {
+        const auto input = InputDescriptor{path};
+        if (input.isRegular()) {
+            file_ = MappedFile{input.get()};
+        } else if (input.get() >= 0) {
+            buffer_ = readAll(input.get());
+        }
+    }
+
+    std::string_view view() const { return buffer_.empty() ? file_.view() : std::string_view{buffer_}; }
+
+private:
+    MappedFile file_;
+    std::string buffer_;
+};
+
+class Lines : public std::ranges::view_interface<Lines> {
+public:
+    Lines() = default;
+    explicit Lines(InputFile file) : file_{std::move(file)} {}
+
+    LineIterator begin() const {
+        const auto data = file_.view();
+        return LineIterator{data.data(), data.data() + data.size()};
+    }
+
+    LineIterator end() const {
+        const auto data = file_.view();
+        return LineIterator{data.data() + data.size(), data.data() + data.size()};
+    }
+
+private:
+    InputFile file_;
+};
+
+inline Lines yieldLines(const std::filesystem::path& path) { return Lines{InputFile{path}}; }
+
+// Single-pass lines of an input. Regular files are mapped as a whole; anything else is read block by block, so lines
+// are handed out as soon as they arrive instead of after the writer closed the pipe.
+class StreamLines : public std::ranges::view_interface<StreamLines> {
+public:
+    class Iterator {
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        explicit Iterator(StreamLines* lines) : lines_{lines} {}
+
+        std::string_view operator*() const { return lines_->line_; }
+
+        Iterator& operator++() {
+            lines_->next();
+            return *this;
+        }
+
+        void operator++(int) { operator++(); }
+
+        bool operator==(std::default_sentinel_t) const { return lines_->done_; }
+
+    private:
+        StreamLines* lines_{nullptr};
+    };
+
+    explicit StreamLines(const std::filesystem::path& path) : input_{path} {
+        if (input_.isRegular()) {
+            file_ = MappedFile{input_.get()};
+            data_ = file_.view().data();
+            end_ = file_.view().size();
+            eof_ = true;
+        } else {
+            buffer_.resize(blockSize);
+            data_ = buffer_.data();
+            eof_ = input_.get() < 0;
+        }
+    }
+
+    StreamLines(StreamLines&&) = default;
+    StreamLines& operator=(StreamLines&&) = default;
+
+    Iterator begin() {
+        next();
+        return Iterator{this};
+    }
+
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    static constexpr auto blockSize = std::size_t{1} << 16;
+
+    void next() {
+        while (true) {
+            const auto* first = data_ + begin_;
+            const auto* eol = (begin_ == end_) ? nullptr
+                                               : static_cast<const char*>(std::memchr(first, '\n', end_ - begin_));
+            if ((eol != nullptr) || (eof_ && (begin_ < end_))) {
+                const auto size = (eol == nullptr) ? (end_ - begin_) : static_cast<std::size_t>(eol - first);
+                line_ = std::string_view{first, size};
+                if (line_.ends_with('\r')) {
+                    line_.remove_suffix(1);
+                }
+                begin_ = std::min(end_, begin_ + size + 1);
+                return;
+            }
+            if (eof_) {
+                done_ = true;
+                return;
+            }
+            refill();
+        }
+    }
+
+    void refill() {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+        if (buffer_.size() - end_ < blockSize) {
+            buffer_.resize(std::max(2 * buffer_.size(), end_ + blockSize));
+        }
+        data_ = buffer_.data();
+
+        const auto count = readSome(input_.get(), buffer_.data() + end_, buffer_.size() - end_);
+        if (count <= 0) {
+            eof_ = true;
+        } else {
+            end_ += static_cast<std::size_t>(count);
+        }
+    }
+
+    InputDescriptor input_;
+    MappedFile file_;
+    std::vector<char> buffer_;
+    const char* data_{nullptr};
+    std::size_t begin_{0};
+    std::size_t end_{0};
+    bool eof_{false};
+    bool done_{false};
+    std::string_view line_;
+};
+
+inline StreamLines streamLines(const std::filesystem::path& path) { return StreamLines{path}; }
+
+inline auto lines(std::string_view data) {
+    const auto* end = data.data() + data.size();
+    return std::ranges::subrange{LineIterator{data.data(), end}, LineIterator{end, end}};
+}
+
+inline std::vector<std::string_view> splitAtLines(std::string_view data, std::size_t nrChunks) {
+    assert(nrChunks > 0);
+
+    const auto chunkSize = std::max<std::size_t>(1, (data.size() + nrChunks - 1) / nrChunks);
+
+    auto result = std::vector<std::string_view>{};
+    while (!data.empty()) {
+        const auto eol = data.find('\n', std::min(chunkSize, data.size()) - 1);
+        const auto size = (eol == std::string_view::npos) ? data.size() : eol + 1;
+        result.push_back(data.substr(0, size));
+        data.remove_prefix(size);
+    }
+
+    return result;
+}
+
+// Monotonic memory for one solver run: deallocation is a no-op and everything is released in one step when the arena
+// is destroyed. Every thread that asks for a resource gets its own buffer, so parallel parsing does not share one.
+class Arena {
+public:
+    Arena() = default;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    std::pmr::memory_resource* resource() {
+        const auto lock = std::scoped_lock{mutex_};
+        auto& result = resources_[std::this_thread::get_id()];
+        if (!result) {
+            result = std::make_unique<std::pmr::monotonic_buffer_resource>();
+        }
+        return result.get();
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::thread::id, std::unique_ptr<std::pmr::monotonic_buffer_resource>> resources_;
+};
+
+namespace detail {
+
+template <typename F>
+auto invokeParser(F& parser, std::string_view line, std::pmr::memory_resource* resource) {
+    if constexpr (std::invocable<F&, std::string_view, std::pmr::memory_resource*>) {
+        return parser(line, resource);
+    } else {
+        return parser(line);
+    }
+}
+
+}  // namespace detail
+
+// Parses every line with parser(line) or parser(line, resource), where resource belongs to the arena.
+template <typename F>
+auto parseLinesParallel(const std::filesystem::path& path, Arena& arena, F parser) {
+    using T = decltype(detail::invokeParser(parser, std::string_view{}, nullptr));
+
+    static constexpr auto minChunkSize = std::size_t{1} << 16;
+
+    const auto file = InputFile{path};
+    const auto data = file.view();
+    const auto nrThreads = ThreadPool::instance().size();
+    const auto chunks = splitAtLines(data, std::clamp<std::size_t>(data.size() / minChunkSize, 1, nrThreads));
+
+    auto parts = std::vector<std::optional<std::pmr::vector<T>>>(chunks.size());
+    const auto parseChunk = [&](std::size_t i) {
+        auto* resource = arena.resource();
+        auto& part = parts[i].emplace(resource);
+        for (auto line : lines(chunks[i])) {
+            part.push_back(detail::invokeParser(parser, line, resource));
+        }
+    };
+
+    {
+        auto group = TaskGroup{};
+        for (auto i = std::size_t{1}; i < chunks.size(); ++i) {
+            group.run([&parseChunk, i] { parseChunk(i); });
+        }
+        if (!chunks.empty()) {
+            parseChunk(0);
+        }
+    }
 
-std::generator<std::string_view> yieldLines(const std::filesystem::path& path) {
-    auto input = std::ifstream{path};
-    auto line = std::string{};
-    while (std::getline(input, line)) {
-        co_yield line;
+    auto result = std::pmr::vector<T>(arena.resource());
+    result.reserve(std::ranges::fold_left(parts, std::size_t{0}, [](auto n, const auto& p) { return n + p->size(); }));
+    for (auto& part : parts) {
+        std::ranges::move(*part, std::back_inserter(result));
     }
+
+    return result;
 }
 
 template <typename T>
@@ -31,27 +455,128 @@ auto operator|(R&& range, as_t<T>) {
     return std::forward<R>(range) | std::views::transform([](const auto& e) { return T{e}; });
 }
 
+namespace detail {
+
+inline std::uint64_t load64(const char* p) {
+    auto result = std::uint64_t{};
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+}
+
+inline std::uint64_t parseEightDigits(std::uint64_t chunk) {
+    static constexpr auto zeroes = std::uint64_t{0x3030303030303030};
+    static constexpr auto mask = std::uint64_t{0x000000FF000000FF};
+    static constexpr auto mul1 = std::uint64_t{100 + (1000000ULL << 32)};
+    static constexpr auto mul2 = std::uint64_t{1 + (10000ULL << 32)};
+
+    chunk -= zeroes;
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+}
+
+// Parses at most eight digits in [first, last). Bytes in [lo, hi) may be read to avoid a byte-wise loop.
+inline std::uint64_t parseShortDigits(const char* first, const char* last, const char* lo, const char* hi) {
+    static constexpr auto zeroes = std::uint64_t{0x3030303030303030};
+
+    const auto size = static_cast<std::size_t>(last - first);
+    assert((size > 0) && (size <= 8));
+
+    if constexpr (std::endian::native == std::endian::little) {
+        const auto padding = 8 * (8 - size);
+        const auto paddingMask = (padding == 0) ? std::uint64_t{0} : (std::uint64_t{1} << padding) - 1;
+
+        if (last - lo >= 8) {
+            return parseEightDigits((load64(last - 8) & ~paddingMask) | (zeroes & paddingMask));
+        }
+        if (hi - first >= 8) {
+            return parseEightDigits((load64(first) << padding) | (zeroes & paddingMask));
+        }
+    }
+
+    return std::ranges::fold_left(std::string_view{first, size}, std::uint64_t{0},
+                                  [](auto acc, char c) { return (acc * 10) + static_cast<std::uint64_t>(c - '0'); });
+}
+
+inline std::uint64_t parseDigits(const char* first, const char* last, const char* lo, const char* hi) {
+    const auto size = static_cast<std::size_t>(last - first);
+    if (size == 0) {
+        return 0;
+    }
+
+    const auto head = ((size - 1) % 8) + 1;
+    auto result = parseShortDigits(first, first + head, lo, hi);
+    for (first += head; first != last; first += 8) {
+        result = (result * 100000000) + parseEightDigits(load64(first));
+    }
+
+    return result;
+}
+
+template <typename F>
+void forEachDelimiter(std::string_view str, char delim, F f) {
+    const auto* p = str.data();
+    const auto* const end = p + str.size();
+
+#if defined(__AVX2__)
+    const auto pattern = _mm256_set1_epi8(delim);
+    for (; end - p >= 32; p += 32) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        for (auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+             mask != 0; mask &= mask - 1) {
+            f(p + std::countr_zero(mask));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const auto pattern128 = _mm_set1_epi8(delim);
+    for (; end - p >= 16; p += 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        for (auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern128)));
+             mask != 0; mask &= mask - 1) {
+            f(p + std::countr_zero(mask));
+        }
+    }
+#endif
+
+    for (; p != end; ++p) {
+        if (*p == delim) {
+            f(p);
+        }
+    }
+}
+
+}  // namespace detail
+
 template <typename T>
 T parseInt(std::string_view sv) {
     assert(sv.find_first_not_of("0123456789") == std::string_view::npos);
 
-    auto result = T{};
-    std::from_chars(sv.begin(), sv.end(), result);
-    return result;
+    const auto* first = sv.data();
+    const auto* last = first + sv.size();
+    return static_cast<T>(detail::parseDigits(first, last, first, last));
 }
 
-template <typename T, std::size_t N, typename R>
-T makeFromRange(R&& range) {
-    static constexpr auto element = [](R& range, auto& it, std::size_t) {
-        assert(it != range.end());
-        return *(it++);
-    };
-    static constexpr auto impl = []<std::size_t... Indices>(R& range, std::index_sequence<Indices...>) {
-        auto it = range.begin();
-        auto result = T{element(range, it, Indices)...};
-        assert(it == range.end());
-        return result;
-    };
+template <typename T, std::size_t N>
+T parseFields(std::string_view str, char delim) {
+    static_assert(N > 0);
+    assert(str.find_first_not_of(std::string{"0123456789"} + delim) == std::string_view::npos);
+
+    const auto* const lo = str.data();
+    const auto* const hi = lo + str.size();
+
+    auto firsts = std::array<const char*, N>{};
+    auto lasts = std::array<const char*, N>{};
+    auto field = std::size_t{0};
+    firsts.front() = lo;
+    detail::forEachDelimiter(str, delim, [&](const char* p) {
+        assert(field + 1 < N);
+        lasts[field] = p;
+        firsts[++field] = p + 1;
+    });
+    assert(field + 1 == N);
+    lasts.back() = hi;
 
-    return impl(range, std::make_index_sequence<N>());
+    return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+        return T{detail::parseDigits(firsts[Indices], lasts[Indices], lo, hi)...};
+    }(std::make_index_sequence<N>());
 }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "shared/instrument.hpp"
+
+#include <array>
+#include <cassert>
+#include <print>
+#include <span>
+#include <string>
+#include <vector>
+
+using Args = std::span<const char* const>;
+using Solver = std::string (*)(Args args);
+
+struct SolverInfo {
+    int day{0};
+    int part{0};
+    Solver solver{nullptr};
+};
+
+inline std::vector<SolverInfo>& solvers() {
+    static auto result = std::vector<SolverInfo>{};
+    return result;
+}
+
+inline bool registerSolver(int day, int part, Solver solver) {
+    solvers().push_back(SolverInfo{.day = day, .part = part, .solver = solver});
+    return true;
+}
+
+// Without arguments the solver reads its input from stdin.
+inline int runMain(int argc, const char** argv, Solver solver) {
+    static constexpr auto stdinArgs = std::array<const char*, 1>{"-"};
+
+    std::println("{}", solver((argc >= 2) ? Args{argv + 1, argv + argc} : Args{stdinArgs}));
+    instrument::report();
+    return 0;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Work-stealing pool: every worker owns a deque, pops its newest task and steals the oldest task of another worker
+// when its own deque is empty. Tasks submitted from a worker go to that worker's deque.
+class ThreadPool {
+public:
+    using Task = std::move_only_function<void()>;
+
+    explicit ThreadPool(std::size_t nrThreads) : queues_(std::max(std::size_t{1}, nrThreads)) {
+        for (auto i = std::size_t{0}; i < queues_.size(); ++i) {
+            threads_.emplace_back([this, i](std::stop_token stop) { work(stop, i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        for (auto& thread : threads_) {
+            thread.request_stop();
+        }
+        {
+            const auto lock = std::scoped_lock{mutex_};
+            stopping_ = true;
+        }
+        wakeup_.notify_all();
+    }
+
+    static ThreadPool& instance() {
+        static auto result = ThreadPool{std::thread::hardware_concurrency()};
+        return result;
+    }
+
+    std::size_t size() const { return queues_.size(); }
+
+    void submit(Task task) {
+        const auto index = (currentPool_ == this) ? currentIndex_ : (next_++ % queues_.size());
+        {
+            auto& queue = queues_[index];
+            const auto lock = std::scoped_lock{queue.mutex};
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            const auto lock = std::scoped_lock{mutex_};
+            ++pending_;
+        }
+        wakeup_.notify_one();
+    }
+
+    // Runs one pending task on the calling thread. Returns false if there was none.
+    bool runPending() {
+        auto task = take();
+        if (!task) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    Task take() {
+        const auto self = (currentPool_ == this) ? currentIndex_ : 0;
+
+        for (auto i = std::size_t{0}; i < queues_.size(); ++i) {
+            auto& queue = queues_[(self + i) % queues_.size()];
+            const auto lock = std::scoped_lock{queue.mutex};
+            if (queue.tasks.empty()) {
+                continue;
+            }
+
+            auto task = Task{};
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            --pending_;
+            return task;
+        }
+
+        return {};
+    }
+
+    void work(std::stop_token stop, std::size_t index) {
+        currentPool_ = this;
+        currentIndex_ = index;
+
+        while (!stop.stop_requested()) {
+            if (runPending()) {
+                continue;
+            }
+
+            auto lock = std::unique_lock{mutex_};
+            wakeup_.wait(lock, [this] { return stopping_ || (pending_ > 0); });
+        }
+    }
+
+    static inline thread_local ThreadPool* currentPool_{nullptr};
+    static inline thread_local std::size_t currentIndex_{0};
+
+    std::deque<Queue> queues_;
+    std::atomic<std::size_t> next_{0};
+    std::atomic<std::size_t> pending_{0};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_{false};
+    std::vector<std::jthread> threads_;
+};
+
+// Runs tasks on a pool and waits for all of them. The waiting thread runs pending tasks itself, so groups can be
+// nested inside pool tasks without starving the pool.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::instance()) : pool_{pool} {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() { wait(); }
+
+    template <typename F>
+    void run(F f) {
+        {
+            const auto lock = std::scoped_lock{mutex_};
+            ++remaining_;
+        }
+        pool_.submit([this, f = std::move(f)]() mutable {
+            f();
+            const auto lock = std::scoped_lock{mutex_};
+            --remaining_;
+            changed_.notify_all();
+        });
+    }
+
+    void wait() {
+        auto lock = std::unique_lock{mutex_};
+        while (remaining_ != 0) {
+            const auto seen = remaining_;
+            lock.unlock();
+            const auto ran = pool_.runPending();
+            lock.lock();
+            if (!ran) {
+                changed_.wait(lock, [this, seen] { return remaining_ != seen; });
+            }
+        }
+    }
+
+private:
+    ThreadPool& pool_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::size_t remaining_{0};
+};